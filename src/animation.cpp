@@ -1,36 +1,254 @@
 #include "animation.hpp"
+#include "memstats.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <numeric>
 
 namespace Application::Helper {
-	void Animation::addAnimation(int frames, int x, int y, int w, int h) {
-		SDL_assert(frames != 0);
+	// gif frames decoded by a single update at most
+	static constexpr int maxStreamCatchUp {4};
 
+	Animation::Animation(std::shared_ptr<RenderQueue> queue) : queuePtr(std::move(queue)) {}
+
+	uint32_t Animation::addClip(std::string_view name, const IMD &sheet, int frames, int x, int y, int w, int h, float duration, bool loops) {
+		MemoryScope scope {MemoryTag::Animation};
+
+		SDL_assert(sheet != nullptr && frames > 0);
+
+		const uint32_t first = static_cast<uint32_t>(frameTextures.size());
+		textures.emplace_back(sheet->texture);
 		for (int i = 0; i < frames; ++i) {
-			SDL_Rect newFrame = {(i + x) * w, y, w, h};
-			this->frames.insert({i, newFrame});
+			frameTextures.emplace_back(sheet->texture.get());
+			frameClips.push_back({(i + x) * w, y, w, h});
+		}
+
+		return addClip(name, first, {duration}, loops);
+	}
+
+	uint32_t Animation::addClip(std::string_view name, const std::vector<IMD> &regions, const std::vector<float> &durations, bool loops) {
+		MemoryScope scope {MemoryTag::Animation};
+
+		SDL_assert(!regions.empty());
+
+		const uint32_t first = static_cast<uint32_t>(frameTextures.size());
+		for (const auto &region : regions) {
+			// pages are shared by several regions, keep each one alive only once
+			if (std::find(textures.begin(), textures.end(), region->texture) == textures.end())
+				textures.emplace_back(region->texture);
+			frameTextures.emplace_back(region->texture.get());
+			frameClips.emplace_back(region->clip);
 		}
+
+		return addClip(name, first, durations, loops);
+	}
+
+	uint32_t Animation::addClip(std::string_view name, uint32_t first, const std::vector<float> &durations, bool loops) {
+		const uint32_t count = static_cast<uint32_t>(frameTextures.size()) - first;
+		SDL_assert(durations.size() == 1 || durations.size() == count);
+
+		// a frame needs some duration or update would never leave it
+		for (uint32_t i = 0; i < count; ++i)
+			frameDurations.emplace_back(std::max(durations.size() == 1 ? durations[0] : durations[i], 1.0f));
+
+		Clip newClip {};
+		newClip.first = first;
+		newClip.count = count;
+		newClip.length = std::accumulate(frameDurations.begin() + first, frameDurations.end(), 0.0f);
+		newClip.loops = loops;
+
+		const uint32_t clip = static_cast<uint32_t>(clips.size());
+		clips.emplace_back(newClip);
+		clipNames.insert_or_assign(std::basic_string<char>(name), clip);
+
+		return clip;
+	}
+
+	int Animation::findClip(std::string_view name) const {
+		auto findClip = clipNames.find(std::basic_string<char>(name));
+		if (findClip == clipNames.end())
+			return -1;
+
+		return static_cast<int>(findClip->second);
+	}
+
+	uint32_t Animation::play(uint32_t clip, float speed) {
+		MemoryScope scope {MemoryTag::Animation};
+
+		SDL_assert(clip < clips.size() && speed >= 0.0f);
+
+		instanceClips.emplace_back(clip);
+		instanceFrames.emplace_back(clips[clip].first);
+		instanceTimes.emplace_back(0.0f);
+		instanceSpeeds.emplace_back(speed);
+
+		return static_cast<uint32_t>(instanceClips.size() - 1);
+	}
+
+	void Animation::setClip(uint32_t instance, uint32_t clip) {
+		SDL_assert(instance < instanceClips.size() && clip < clips.size());
+
+		instanceClips[instance] = clip;
+		instanceFrames[instance] = clips[clip].first;
+		instanceTimes[instance] = 0.0f;
 	}
 
-	void Animation::update(float speed, double dt) {
-		if (frames.size() > 0) {
-			frameTime += static_cast<float>(dt);
+	void Animation::setSpeed(uint32_t instance, float speed) {
+		SDL_assert(instance < instanceSpeeds.size() && speed >= 0.0f);
+		instanceSpeeds[instance] = speed;
+	}
+
+	void Animation::setStream(std::shared_ptr<GifStream> gif, IMD img) {
+		gifPtr = std::move(gif);
+		streamImg = std::move(img);
+		streamIsDirty = true;
+		streamTime = 0.0f;
+	}
+
+	bool Animation::updateStream(double dt) {
+		MemoryScope scope {MemoryTag::Animation};
+
+		if (gifPtr == nullptr)
+			return false;
 
-			if (frameTime >= speed) {
-				frameTime = 0.0f;
-				currentFrame = (currentFrame + 1) % static_cast<int>(frames.size());
+		streamTime += static_cast<float>(dt);
+
+		// the remainder carries over & a long frame is caught up on, but every step is a decode,
+		// so past a few of them the backlog is dropped (keeping the phase within the frame) instead of racing through it
+		bool hasChanged = false;
+		for (int decoded = 0; streamTime >= static_cast<float>(gifPtr->current()->delay); ++decoded) {
+			const float delay = static_cast<float>(gifPtr->current()->delay);
+			if (decoded == maxStreamCatchUp) {
+				streamTime = std::fmod(streamTime, delay);
+				break;
+			}
+
+			streamTime -= delay;
+			if (gifPtr->next() == nullptr) {
+				std::cout << "Failed to decode gif frame, stopping the stream\n";
+				gifPtr.reset();
+				return false;
 			}
+			streamIsDirty = true;
+			hasChanged = true;
 		}
+
+		return hasChanged;
 	}
 
-	void Animation::draw(IMD &img, SDL_Renderer *ren, int x, int y, double scale){
-		SDL_Rect clip = frames[currentFrame];
+	bool Animation::update(double dt) {
+		PROFILE_ZONE("Animation::update");
+
+		bool hasChanged = updateStream(dt);
+
+		const float elapsed = static_cast<float>(dt);
+		for (size_t i = 0; i < instanceClips.size(); ++i) {
+			const Clip &clip = clips[instanceClips[i]];
+			const uint32_t last = clip.first + clip.count - 1;
+			uint32_t frame = instanceFrames[i];
+			// time spent on the current frame, the remainder is carried to the next one
+			float time = instanceTimes[i] + elapsed * instanceSpeeds[i];
+
+			// a whole loop ends on the same frame, only the rest has to be stepped through
+			if (clip.loops && time >= clip.length)
+				time = std::fmod(time, clip.length);
+
+			while (time >= frameDurations[frame]) {
+				// hold the last frame
+				if (frame == last && !clip.loops) {
+					time = frameDurations[frame];
+					break;
+				}
+
+				time -= frameDurations[frame];
+				frame = frame == last ? clip.first : frame + 1;
+			}
+
+			hasChanged |= frame != instanceFrames[i];
+			instanceFrames[i] = frame;
+			instanceTimes[i] = time;
+		}
+
+		return hasChanged;
+	}
+
+	double Animation::getTimeToNextFrame() const noexcept {
+		double timeout = std::numeric_limits<double>::infinity();
+
+		if (gifPtr != nullptr)
+			timeout = std::max(0.0, static_cast<double>(gifPtr->current()->delay - streamTime));
+
+		for (size_t i = 0; i < instanceClips.size(); ++i) {
+			const Clip &clip = clips[instanceClips[i]];
+			const uint32_t frame = instanceFrames[i];
+			// paused or holding the last frame
+			if (instanceSpeeds[i] <= 0.0f || (!clip.loops && frame == clip.first + clip.count - 1))
+				continue;
+
+			const double left = (frameDurations[frame] - instanceTimes[i]) / instanceSpeeds[i];
+			timeout = std::min(timeout, std::max(0.0, left));
+		}
+
+		return timeout;
+	}
+
+	void Animation::draw(uint32_t instance, SDL_Renderer *ren, int x, int y, double scale) {
+		SDL_assert(instance < instanceFrames.size());
+
+		// frames carry their own page
+		const uint32_t frame = instanceFrames[instance];
+		const SDL_Rect &clip = frameClips[frame];
 		SDL_Rect dst {x, y, clip.w, clip.h};
-		
+
 		if (scale != 0) {
-			dst.w *= static_cast<int>(scale);
-			dst.h *= static_cast<int>(scale);
+			dst.w = static_cast<int>(std::lround(dst.w * scale));
+			dst.h = static_cast<int>(std::lround(dst.h * scale));
 		}
 
-		SDL_RenderCopy(ren, img->texture.get(), &clip, &dst);
+		queuePtr->copy(ren, frameTextures[frame], &clip, dst);
+	}
+
+	bool Animation::prepareStream(IMD &img, SDL_Renderer *ren) {
+		if (gifPtr == nullptr || img != streamImg)
+			return false;
+
+		if (streamIsDirty) {
+			// quads still waiting in the queue would pick up the new frame
+			queuePtr->flush(ren);
+			SDL_UpdateTexture(img->texture.get(), nullptr, gifPtr->current()->pixels, gifPtr->getWidth() * sizeof(uint32_t));
+			streamIsDirty = false;
+		}
+
+		return true;
+	}
+
+	void Animation::draw(IMD &img, SDL_Renderer *ren, int x, int y, double scale) {
+		if (!prepareStream(img, ren))
+			return;
+
+		SDL_Rect dst {x, y, gifPtr->getWidth(), gifPtr->getHeight()};
+		if (scale != 0) {
+			dst.w = static_cast<int>(std::lround(dst.w * scale));
+			dst.h = static_cast<int>(std::lround(dst.h * scale));
+		}
+
+		queuePtr->copy(ren, img->texture.get(), nullptr, dst);
+	}
+
+	void Animation::draw(IMD &img, SDL_Renderer *ren, const SDL_Rect &dst) {
+		if (!prepareStream(img, ren) || dst.w <= 0 || dst.h <= 0)
+			return;
+
+		// the largest part of the gif with the aspect ratio of dst, the renderer scales it to fit
+		const int width = gifPtr->getWidth();
+		const int height = gifPtr->getHeight();
+		const double scale = std::max(static_cast<double>(dst.w) / width, static_cast<double>(dst.h) / height);
+		SDL_Rect clip {0, 0, std::min(width, static_cast<int>(std::lround(dst.w / scale))), std::min(height, static_cast<int>(std::lround(dst.h / scale)))};
+		clip.x = (width - clip.w) / 2;
+		clip.y = (height - clip.h) / 2;
+
+		queuePtr->copy(ren, img->texture.get(), &clip, dst);
 	}
-} // namespace Application::Helper
+} // namespace Application::Helper
\ No newline at end of file
@@ -2,37 +2,130 @@
 
 #include <SDL.h>
 #include "data.hpp"
-#include <map>
+#include "gif.hpp"
+#include "renderqueue.hpp"
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
-// add a sprite sheet and iterate over it (assuming the spritesheet is exactly the same width and height)
+/** Structure
+ *
+ * Clip -> a named run of frames, each frame has its own texture (atlas page), clip & duration
+ * Instance -> plays a clip at its own speed, any number of instances can play the same clip
+ * Stream -> an animated gif, frames are decoded on demand and shown for their own delay
+ *
+ *	frames  [ c0 f0 | c0 f1 | c0 f2 | c1 f0 | c1 f1 | ... ]   every clip is a range of the same arrays
+ *	           ^ instance 0          ^ instance 1
+ *
+ *  update advances every instance in one pass, the remainder of a frame carries over (no drift)
+ */
 
 namespace Application::Helper {
 	class Animation {
 	public:
-		//constexpr uint32_t getCurrentFrame();
-		/** Quick animation creation
+		/** Create an animation.
 		 *
-		 * \param frames -> number of frames in the gif extraction
-		 * \param x -> x position of the image
-		 * \param y -> y position of the image
-		 * \param w -> width of the image (pixel width)
-		 * \param h -> height of the image (pixel height)
-		 * \return void -> no return available.
+		 * \param queue -> the queue frames are submitted to
 		 */
-		void addAnimation(int frames, int x, int y, int w, int h);
-		//void setCurrentFrame(std::string_view frameName);
-		//void stopAnimation();
-		
-		// speed -> how fast the animation should play
-		void update(float speed, double dt);
+		explicit Animation(std::shared_ptr<RenderQueue> queue);
+		/** Add a clip from a sprite sheet (assuming every frame is exactly the same width and height).
+		 *
+		 * \param name -> the name of the clip
+		 * \param sheet -> the sprite sheet
+		 * \param frames -> number of frames in the sheet
+		 * \param x -> x position of the first frame (in frames)
+		 * \param y -> y position of the first frame (pixel height)
+		 * \param w -> width of a frame (pixel width)
+		 * \param h -> height of a frame (pixel height)
+		 * \param duration -> how long every frame is shown (ms)
+		 * \param loops -> start over after the last frame, otherwise hold it
+		 * \return the clip.
+		 */
+		uint32_t addClip(std::string_view name, const IMD &sheet, int frames, int x, int y, int w, int h, float duration, bool loops = true);
+		/** Add a clip from atlas regions (Image::getPackFrames), each frame can live on a different page.
+		 *
+		 * \param name -> the name of the clip
+		 * \param regions -> the frames, drawn with their own texture & clip
+		 * \param durations -> how long each frame is shown (ms), a single duration is used for every frame
+		 * \param loops -> start over after the last frame, otherwise hold it
+		 * \return the clip.
+		 */
+		uint32_t addClip(std::string_view name, const std::vector<IMD> &regions, const std::vector<float> &durations, bool loops = true);
+		/** Find a clip by its name.
+		 *
+		 * \param name -> the name of the clip
+		 * \return the clip or -1 if it was not found.
+		 */
+		int findClip(std::string_view name) const;
+		/** Start playing a clip on a new instance.
+		 *
+		 * \param clip -> the clip to play
+		 * \param speed -> playback rate (1 plays the frames for their own duration)
+		 * \return the instance.
+		 */
+		uint32_t play(uint32_t clip, float speed = 1.0f);
+		// restart an instance with another clip
+		void setClip(uint32_t instance, uint32_t clip);
+		// 0 pauses the instance
+		void setSpeed(uint32_t instance, float speed);
+		/** Play a gif stream, it's drawn with the image it was created with.
+		 *
+		 * \param gif -> the opened gif stream
+		 * \param img -> the streaming texture the frames are uploaded to (same size as the gif)
+		 */
+		void setStream(std::shared_ptr<GifStream> gif, IMD img);
+
+		// advances every instance & the stream
+		// returns true when anything moved to another frame
+		bool update(double dt);
+		// time left (ms) until update moves anything to another frame
+		double getTimeToNextFrame() const noexcept;
+		// draws the current frame of an instance
+		void draw(uint32_t instance, SDL_Renderer *ren, int x, int y, double scale = 0.0);
+		// draws the gif stream if img is its texture
 		void draw(IMD &img, SDL_Renderer *ren, int x, int y, double scale = 0.0);
+		// draws the gif stream if img is its texture, covering dst (the overflow is cropped around the centre)
+		void draw(IMD &img, SDL_Renderer *ren, const SDL_Rect &dst);
 
 	private:
-		float frameTime {0.0f};
-		int currentFrame {0};
-		std::basic_string<char> animStr {};
-		// make this an unordered_map?
-		std::map<unsigned int, SDL_Rect> frames {};
+		uint32_t addClip(std::string_view name, uint32_t first, const std::vector<float> &durations, bool loops);
+		bool updateStream(double dt);
+		// uploads the decoded frame if img is the stream's texture, returns false if it isn't
+		bool prepareStream(IMD &img, SDL_Renderer *ren);
+
+	private:
+		struct Clip final {
+			// range in the frame arrays
+			uint32_t first {0};
+			uint32_t count {0};
+			// sum of the frame durations
+			float length {0.0f};
+			bool loops {true};
+		};
+
+		std::shared_ptr<RenderQueue> queuePtr {nullptr};
+
+		// frames of every clip
+		std::vector<SDL_Texture *> frameTextures {};
+		std::vector<SDL_Rect> frameClips {};
+		std::vector<float> frameDurations {};
+		// keeps the sheets & atlas pages alive
+		std::vector<std::shared_ptr<SDL_Texture>> textures {};
+
+		std::vector<Clip> clips {};
+		std::unordered_map<std::basic_string<char>, uint32_t> clipNames {};
+
+		// instances, the frame is an index into the frame arrays
+		std::vector<uint32_t> instanceClips {};
+		std::vector<uint32_t> instanceFrames {};
+		std::vector<float> instanceTimes {};
+		std::vector<float> instanceSpeeds {};
+
+		// gif stream, the decoded frame is uploaded the next time it is drawn
+		std::shared_ptr<GifStream> gifPtr {nullptr};
+		IMD streamImg {nullptr};
+		float streamTime {0.0f};
+		bool streamIsDirty {false};
 	};
 } // namespace Application::Helper
\ No newline at end of file
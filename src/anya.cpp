@@ -1,9 +1,17 @@
 #include <SDL_syswm.h>
 #include "anya.hpp"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
+#include <iterator>
+#include <utility>
 
 namespace Application {
-	Anya::Anya() {
+	Anya::Anya(int argc, char **argv, bool shouldLoop) : launchOptions(Helper::parseLaunchOptions(argc, argv)) {
+		if (!shouldLoop)
+			return;
+
 		if (!boot()) {
 			SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, title.c_str(), errStr.c_str(), window.get());
 		} else {
@@ -11,12 +19,6 @@ namespace Application {
 		}
 	}
 
-#ifdef _DEBUG
-	Anya::Anya(const std::chrono::system_clock::time_point &time) {
-		str << timeToStr(time);
-	}
-#endif
-
 	// make this a cross platform function (void * for handle)
 #ifdef _WIN32 
 	static void setWindowShadow(HWND handle, const MARGINS &margins) {
@@ -30,12 +32,11 @@ namespace Application {
 		SDL_assert(IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG) != 0);
 		if (TTF_Init() == -1) return false;
 
-		begin = std::chrono::steady_clock::now();
-
 		SDL_SetHintWithPriority("SDL_BORDERLESS_WINDOWED_STYLE", "1", SDL_HINT_OVERRIDE);
 
 		window = PTR<SDL_Window>(SDL_CreateWindow(title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, windowWidth, windowHeight, 0));
-		renderer = PTR<SDL_Renderer>(SDL_CreateRenderer(window.get(), -1, SDL_RENDERER_SOFTWARE));
+		if (window)
+			renderer = Helper::createRenderer(window.get(), launchOptions.renderer, isVSync);
 		if (!window || !renderer) {
 			errStr = SDL_GetError();
 			std::cout << "failed to boot: " << errStr << '\n';
@@ -67,41 +68,64 @@ namespace Application {
 
 		// initialize components
 		imagePtr = std::make_unique<Helper::Image>();
-		interfacePtr = std::make_unique<Helper::UInterface>();
+		interfacePtr = std::make_unique<Helper::UInterface>(imagePtr->getQueuePtr(), imagePtr->getTextPtr());
 		scenePtr = std::make_unique<Helper::Scene>();
+		imagePtr->getCache().setBudget(static_cast<size_t>(cacheBudget));
 
 		// set the default font
-		typographyStr = dirPath + "assets/Onest.ttf";
-
-		// load assets
-		backgroundGIF = imagePtr->createPack("canvas", dirPath + "assets/gif-extract/", renderer.get());
-		backgroundImg = imagePtr->createImage(dirPath + "assets/beep_1.png", renderer.get());
-		githubImg = imagePtr->createImage(dirPath + "assets/25231.png", renderer.get());
-		calendarImg = imagePtr->createImage(dirPath + "assets/calendar.png", renderer.get());
-		typographyImg = imagePtr->createImage(dirPath + "assets/typography.png", renderer.get());
-		returnImg = imagePtr->createImage(dirPath + "assets/return.png", renderer.get());
-		setThemeImg = imagePtr->createImage(dirPath + "assets/paintbrush.png", renderer.get());
-		imagePtr->getAnimPtr()->addAnimation(68, 0, 0, 148, 89);
-
-		// create scenes
-		scenePtr->createScene("Main");
-		scenePtr->createScene("Settings");
-		scenePtr->createScene("Settings-Themes");
-		scenePtr->createScene("Themes-Background-Color");
+		fontPath = dirPath + "assets/Onest.ttf";
+		typographyStr = fontPath;
+
+		// prebaked pixels are used when the bundle was built (tools/packer.cpp), files are decoded otherwise
+		if (std::filesystem::exists(dirPath + "assets.bundle"))
+			imagePtr->openBundle(dirPath + "assets.bundle", dirPath + "assets/");
+
+		// load assets, the background is decoded on the worker pool while the icons are packed & the gif is opened
+		imagePtr->loadAsync(dirPath + "assets/beep_1.png", renderer.get(), [this](Helper::IMD img) {backgroundImg = img;});
+
+		// every icon shares one atlas page (they are all tinted the same), scaled once to the button it's drawn in
+		const auto icons = imagePtr->createAtlas({
+			dirPath + "assets/25231.png",
+			dirPath + "assets/calendar.png",
+			dirPath + "assets/typography.png",
+			dirPath + "assets/return.png",
+			dirPath + "assets/paintbrush.png"
+		}, renderer.get(), {{25, 25}, {25, 25}, {25, 25}, {12, 12}, {25, 25}});
+		githubImg = icons[0];
+		calendarImg = icons[1];
+		typographyImg = icons[2];
+		returnImg = icons[3];
+		setThemeImg = icons[4];
+
+		backgroundGIF = imagePtr->createGif(dirPath + "assets/app.gif", renderer.get());
+		// fall back to the pre-extracted frames when the gif can't be streamed
+		if (backgroundGIF == nullptr && std::filesystem::exists(dirPath + "assets/gif-extract/")) {
+			backgroundGIF = imagePtr->createPack("canvas", dirPath + "assets/gif-extract/", renderer.get());
+			if (backgroundGIF != nullptr) {
+				auto animPtr = imagePtr->getAnimPtr();
+				backgroundAnim = static_cast<int>(animPtr->play(animPtr->addClip("canvas", imagePtr->getPackFrames("canvas"), {animSpeed})));
+			}
+		}
+
+		// wait for the background upload
+		imagePtr->finish(renderer.get());
+
+		// dropping a gif on the window sets it as the background
+		SDL_EventState(SDL_DROPFILE, SDL_ENABLE);
+
+		Helper::setMemoryBudget(memoryBudget);
+		checkMemoryBudget();
 
 		// main
 		settingsBtn = interfacePtr->createButton("+", 5, 5, 20, 20);
-		settingsBtn->isEnabled = true;
+		interfacePtr->setButtonEnabled(settingsBtn, true);
 		mainQuitBtn = interfacePtr->createButton("x", 103, 5, 12, 12);
-		mainQuitBtn->canQuit = true;
 		minimizeBtn = interfacePtr->createButton("-", 85, 5, 12, 12);
-		minimizeBtn->canMinimize = true;
 		returnBtn = interfacePtr->createButton("", returnImg, 67, 5, 12, 12);
 
 		// settings
 		settingsQuitBtn = interfacePtr->createButton("Quit", 108, 5, 35, 25);
-		settingsQuitBtn->canQuit = true;
-		settingsQuitBtn->isEnabled = true;
+		interfacePtr->setButtonEnabled(settingsQuitBtn, true);
 		settingsExitBtn = interfacePtr->createButton("x", 65, 60, 20, 20);
 		themesBtn = interfacePtr->createButton("Themes", 39, 5, 60, 25);
 		githubBtn = interfacePtr->createButton("", githubImg, 5, 5, 25, 25);
@@ -114,406 +138,774 @@ namespace Application {
 		openFileBtn = interfacePtr->createButton("Open File", 25, 35, 50, 15);
 		setBGColorBtn = interfacePtr->createButton("Set Color", 80, 35, 50, 15);
 		setTypographyBtn = interfacePtr->createButton("", typographyImg, 5, 5, 25, 25);
-		typographyInputBtn = interfacePtr->createButton("Set Font", setTypographyBtn->box.w / 2, 35, 120, 15);
+		typographyInputBtn = interfacePtr->createButton("Set Font", interfacePtr->getButtonBox(setTypographyBtn).w / 2, 35, 120, 15);
 		setThemeBtn = interfacePtr->createButton("", setThemeImg, 5, 39, 25, 25);
 
-		for (auto &button : interfacePtr->getButtonList())
-			interfacePtr->setButtonTheme(button, {{67, 48, 46}, {168, 124, 116}, {240, 209, 189}});
+		interfacePtr->setTheme({{67, 48, 46}, {168, 124, 116}, {240, 209, 189}});
 
-		imagePtr->setTextureColor(githubImg, {240, 209, 189, (uint8_t)githubBtn->colorAlpha});
-		imagePtr->setTextureColor(calendarImg, {240, 209, 189, (uint8_t)calendarBtn->colorAlpha});
-		imagePtr->setTextureColor(typographyImg, {240, 209, 189, (uint8_t)setTypographyBtn->colorAlpha});
-		imagePtr->setTextureColor(returnImg, {240, 209, 189, (uint8_t)returnBtn->colorAlpha});
-		imagePtr->setTextureColor(setThemeImg, {240, 209, 189, (uint8_t)setThemeBtn->colorAlpha});
+		// click handlers
+		interfacePtr->setButtonCallback(settingsBtn, Helper::SceneID::Main, [this] {
+			scenePtr->setScene(Helper::SceneID::Settings);
+			interfacePtr->setButtonEnabled(settingsBtn, false);
+		});
 
-		// set the scene to be displayed
-		scenePtr->setScene("Main");
+		interfacePtr->setButtonCallback(mainQuitBtn, Helper::SceneID::Main, [this] {
+			shouldRun = false;
+		});
 
-		shouldRun = true;
+		interfacePtr->setButtonCallback(minimizeBtn, Helper::SceneID::Main, [this] {
+			SDL_MinimizeWindow(window.get());
+		});
 
-		return true;
-	}
+		interfacePtr->setButtonCallback(returnBtn, Helper::SceneID::Main, [this] {
+			if (!minimalMode)
+				return;
 
-	void Anya::update() {
-		while (shouldRun) {
-			SDL_PollEvent(&ev);
-
-			switch (ev.type) {
-				case SDL_QUIT: {
-					shouldRun = false;
-				} break;
-
-				case SDL_MOUSEBUTTONDOWN: {
-					for (auto &button : interfacePtr->getButtonList()) {
-						if (button->canMinimize && interfacePtr->cursorInBounds(button, interfacePtr->getMousePos()))
-							if (scenePtr->getCurrentScene() == scenePtr->findScene("Main") && minimizeBtn->isEnabled)
-								SDL_MinimizeWindow(window.get());
-
-						if (button->canQuit && interfacePtr->cursorInBounds(button, interfacePtr->getMousePos())) {
-							if (scenePtr->getCurrentScene() == scenePtr->findScene("Settings"))
-								shouldRun = false;
-
-							if (scenePtr->getCurrentScene() == scenePtr->findScene("Main") && mainQuitBtn->isEnabled)
-								shouldRun = false;
-						}
-					}
+			minimalMode = false;
+			interfacePtr->setButtonEnabled(themesExitBtn, true);
+			SDL_SetWindowBordered(window.get(), SDL_TRUE);
+			SDL_SetWindowSize(window.get(), windowWidth, windowHeight);
+#ifdef _WIN32
+			setWindowShadow(hwnd, {0, 0, 0, 0});
+#endif
+			scenePtr->setScene(Helper::SceneID::SettingsThemes);
+		});
 
-					if (interfacePtr->cursorInBounds(settingsBtn, interfacePtr->getMousePos()) && settingsBtn->isEnabled) {
-						scenePtr->setScene("Settings");
-						settingsBtn->isEnabled = false;
-					}
+		interfacePtr->setButtonCallback(settingsQuitBtn, Helper::SceneID::Settings, [this] {
+			shouldRun = false;
+		});
 
-					if (interfacePtr->cursorInBounds(githubBtn, interfacePtr->getMousePos()) && githubBtn->isEnabled) {
+		interfacePtr->setButtonCallback(githubBtn, Helper::SceneID::Settings, [] {
 #ifdef _WIN32
-						ShellExecute(0, 0, L"https://www.github.com/inohime", 0, 0, SW_SHOW);
+			ShellExecute(0, 0, L"https://www.github.com/inohime", 0, 0, SW_SHOW);
 #elif defined __linux__
-						system("xdg-open https://www.github.com/inohime");
+			system("xdg-open https://www.github.com/inohime");
 #endif
-					}
+		});
+
+		interfacePtr->setButtonCallback(settingsExitBtn, Helper::SceneID::Settings, [this] {
+			scenePtr->setScene(Helper::SceneID::Main);
+			interfacePtr->setButtonEnabled(settingsExitBtn, false);
+			interfacePtr->setButtonEnabled(themesBtn, false);
+			interfacePtr->setButtonEnabled(githubBtn, false);
+			interfacePtr->setButtonEnabled(calendarBtn, false);
+			interfacePtr->setButtonEnabled(settingsBtn, true);
+		});
+
+		interfacePtr->setButtonCallback(themesBtn, Helper::SceneID::Settings, [this] {
+			scenePtr->setScene(Helper::SceneID::SettingsThemes);
+			interfacePtr->setButtonEnabled(themesBtn, false);
+			interfacePtr->setButtonEnabled(githubBtn, false);
+			interfacePtr->setButtonEnabled(calendarBtn, false);
+			interfacePtr->setButtonEnabled(themesExitBtn, true);
+			interfacePtr->setButtonEnabled(settingsExitBtn, false);
+		});
+
+		interfacePtr->setButtonCallback(calendarBtn, Helper::SceneID::Settings, [this] {
+			showDate = !showDate;
+		});
+
+		interfacePtr->setButtonCallback(setBGBtn, Helper::SceneID::SettingsThemes, [this] {
+			if (!setBGIsPressed) {
+				setTypographyIsPressed = false;
+				setBGIsPressed = true;
+				interfacePtr->setButtonEnabled(openFileBtn, true);
+				interfacePtr->setButtonEnabled(setBGColorBtn, true);
+			} else {
+				setBGIsPressed = false;
+				setBGToFile = false;
+				interfacePtr->setButtonEnabled(openFileBtn, false);
+				interfacePtr->setButtonEnabled(setBGColorBtn, false);
+			}
+		});
 
-					if (interfacePtr->cursorInBounds(settingsExitBtn, interfacePtr->getMousePos()) && settingsExitBtn->isEnabled) {
-						scenePtr->setScene("Main");
-						settingsExitBtn->isEnabled = false;
-						themesBtn->isEnabled = false;
-						githubBtn->isEnabled = false;
-						calendarBtn->isEnabled = false;
-						settingsBtn->isEnabled = true;
-					}
+		interfacePtr->setButtonCallback(setTypographyBtn, Helper::SceneID::SettingsThemes, [this] {
+			if (!setTypographyIsPressed) {
+				setTypographyIsPressed = true;
+				setBGIsPressed = false;
+				interfacePtr->setButtonEnabled(typographyInputBtn, true);
+			} else {
+				setTypographyIsPressed = false;
+				interfacePtr->setButtonEnabled(typographyInputBtn, false);
+			}
+		});
+
+		interfacePtr->setButtonCallback(typographyInputBtn, Helper::SceneID::SettingsThemes, [this] {
+			interfacePtr->getButtonText(typographyInputBtn) = "";
+		});
+
+		interfacePtr->setButtonCallback(setBGColorBtn, Helper::SceneID::SettingsThemes, [this] {
+			setBGToColor = true;
+			setBGToFile = false;
+			interfacePtr->getButtonText(setBGColorBtn) = "";
+		});
+
+		// type the path of an image, enter loads it
+		interfacePtr->setButtonCallback(openFileBtn, Helper::SceneID::SettingsThemes, [this] {
+			setBGToFile = true;
+			interfacePtr->getButtonText(openFileBtn) = "";
+		});
+
+		interfacePtr->setButtonCallback(minimalBtn, Helper::SceneID::SettingsThemes, [this] {
+			minimalMode = true;
+			interfacePtr->setButtonEnabled(themesExitBtn, false);
+			interfacePtr->setButtonEnabled(minimalBtn, false);
+			interfacePtr->setButtonEnabled(setBGBtn, false);
+			interfacePtr->setButtonEnabled(openFileBtn, false);
+			SDL_SetWindowBordered(window.get(), SDL_FALSE);
+			SDL_SetWindowSize(window.get(), 120, 50);
+#ifdef _WIN32
+			setWindowShadow(hwnd, {0, 0, 0, 1});
+#endif
+			scenePtr->setScene(Helper::SceneID::Main);
+		});
+
+		interfacePtr->setButtonCallback(themesExitBtn, Helper::SceneID::SettingsThemes, [this] {
+			scenePtr->setScene(Helper::SceneID::Settings);
+			interfacePtr->setButtonEnabled(settingsExitBtn, true);
+			interfacePtr->setButtonEnabled(themesExitBtn, false);
+			interfacePtr->setButtonEnabled(minimalBtn, false);
+			interfacePtr->setButtonEnabled(setBGBtn, false);
+			interfacePtr->setButtonEnabled(openFileBtn, false);
+			interfacePtr->setButtonEnabled(setTypographyBtn, false);
+			setBGIsPressed = false;
+			setTypographyIsPressed = false;
+		});
+
+		imagePtr->setTextureColor(githubImg, {240, 209, 189, (uint8_t)interfacePtr->getButtonAlpha(githubBtn)});
+		imagePtr->setTextureColor(calendarImg, {240, 209, 189, (uint8_t)interfacePtr->getButtonAlpha(calendarBtn)});
+		imagePtr->setTextureColor(typographyImg, {240, 209, 189, (uint8_t)interfacePtr->getButtonAlpha(setTypographyBtn)});
+		imagePtr->setTextureColor(returnImg, {240, 209, 189, (uint8_t)interfacePtr->getButtonAlpha(returnBtn)});
+		imagePtr->setTextureColor(setThemeImg, {240, 209, 189, (uint8_t)interfacePtr->getButtonAlpha(setThemeBtn)});
+
+		// create scenes, only the hooks of the shown scene run
+		scenePtr->createScene(Helper::SceneID::Main, {
+			.enter = [this] {
+				// minimal mode has no settings button, quit/minimize/return take its place
+				interfacePtr->setButtonEnabled(mainQuitBtn, minimalMode);
+				interfacePtr->setButtonEnabled(minimizeBtn, minimalMode);
+				interfacePtr->setButtonEnabled(returnBtn, minimalMode);
+			},
+			.update = [this](double dt) {
+				// a hidden gif holds its frame, nothing is decoded for it
+				if (isGIFVisible() && imagePtr->getAnimPtr()->update(dt))
+					needsRedraw = true;
+			},
+			.draw = [this] {drawMainScene();},
+			// keep the returnBtn from being clickable through the Settings-Theme layer
+			.exit = [this] {
+				interfacePtr->setButtonEnabled(mainQuitBtn, false);
+				interfacePtr->setButtonEnabled(minimizeBtn, false);
+				interfacePtr->setButtonEnabled(returnBtn, false);
+			}
+		});
+
+		scenePtr->createScene(Helper::SceneID::Settings, {
+			// the first layer's buttons are disabled, enable this layer
+			.enter = [this] {
+				interfacePtr->setButtonEnabled(settingsExitBtn, true);
+				interfacePtr->setButtonEnabled(themesBtn, true);
+				interfacePtr->setButtonEnabled(githubBtn, true);
+				interfacePtr->setButtonEnabled(calendarBtn, true);
+			},
+			.draw = [this] {drawSettingsScene();}
+		});
+
+		scenePtr->createScene(Helper::SceneID::SettingsThemes, {
+			// the second layer's buttons are disabled, enable this layer
+			.enter = [this] {
+				interfacePtr->setButtonEnabled(setBGBtn, true);
+				interfacePtr->setButtonEnabled(minimalBtn, true);
+				interfacePtr->setButtonEnabled(setTypographyBtn, true);
+			},
+			.draw = [this] {drawSettingsThemesScene();}
+		});
+
+		scenePtr->createScene(Helper::SceneID::ThemesBackgroundColor, {});
 
-					if (interfacePtr->cursorInBounds(themesBtn, interfacePtr->getMousePos()) && themesBtn->isEnabled) {
-						scenePtr->setScene("Settings-Themes");
-						themesBtn->isEnabled = false;
-						githubBtn->isEnabled = false;
-						calendarBtn->isEnabled = false;
-						themesExitBtn->isEnabled = true;
-						settingsExitBtn->isEnabled = false;
-					}
+		// set the scene to be displayed
+		scenePtr->setScene(Helper::SceneID::Main);
 
-					if (interfacePtr->cursorInBounds(calendarBtn, interfacePtr->getMousePos()) && calendarBtn->isEnabled && !showDate) {
-						showDate = true;
-					} else if (interfacePtr->cursorInBounds(calendarBtn, interfacePtr->getMousePos()) && calendarBtn->isEnabled && showDate) {
-						showDate = false;
-					}
+		// a trace that can't be read is reported, the app still runs
+		if (!launchOptions.recordPath.empty()) {
+			recorderPtr = std::make_unique<Helper::EventRecorder>();
+			if (!recorderPtr->open(launchOptions.recordPath))
+				recorderPtr.reset();
+		}
+		if (!launchOptions.replayPath.empty()) {
+			replayerPtr = std::make_unique<Helper::EventReplayer>();
+			if (!replayerPtr->open(launchOptions.replayPath))
+				replayerPtr.reset();
+		}
 
-					if (interfacePtr->cursorInBounds(setBGBtn, interfacePtr->getMousePos()) && setBGBtn->isEnabled && !setBGIsPressed) {
-						setTypographyIsPressed = false;
-						setBGIsPressed = true;
-						openFileBtn->isEnabled = true;
-						setBGColorBtn->isEnabled = true;
-					} else if (interfacePtr->cursorInBounds(setBGBtn, interfacePtr->getMousePos()) && setBGBtn->isEnabled && setBGIsPressed) {
-						setBGIsPressed = false;
-						openFileBtn->isEnabled = false;
-						setBGColorBtn->isEnabled = false;
-					}
+		if (launchOptions.clock == "fixed") {
+			const auto start = launchOptions.clockStart < 0 ? std::chrono::system_clock::now() : std::chrono::system_clock::time_point(std::chrono::seconds(launchOptions.clockStart));
+			clock = Helper::Clock(start, std::chrono::milliseconds(launchOptions.clockStep));
+		}
 
-					if (interfacePtr->cursorInBounds(setTypographyBtn, interfacePtr->getMousePos()) && setTypographyBtn->isEnabled && !setTypographyIsPressed) {
-						setTypographyIsPressed = true;
-						setBGIsPressed = false;
-						typographyInputBtn->isEnabled = true;
-					} else if (interfacePtr->cursorInBounds(setTypographyBtn, interfacePtr->getMousePos()) && setTypographyBtn->isEnabled && setTypographyIsPressed) {
-						setTypographyIsPressed = false;
-						typographyInputBtn->isEnabled = false;
-					}
+		tick = 0;
+		shouldRun = true;
 
-					if (interfacePtr->cursorInBounds(typographyInputBtn, interfacePtr->getMousePos()) && typographyInputBtn->isEnabled) {
-						typographyInputBtn->text = "";
-					}
+		return true;
+	}
 
-					if (interfacePtr->cursorInBounds(setBGColorBtn, interfacePtr->getMousePos()) && setBGColorBtn->isEnabled) {
-						setBGToColor = true;
-						setBGColorBtn->text = "";
-					}
+	void Anya::update() {
+		while (step()) {}
+		free();
+	}
 
-					if (interfacePtr->cursorInBounds(minimalBtn, interfacePtr->getMousePos()) && minimalBtn->isEnabled) {
-						minimalMode = true;
-						themesExitBtn->isEnabled = false;
-						minimalBtn->isEnabled = false;
-						setBGBtn->isEnabled = false;
-						openFileBtn->isEnabled = false;
-						SDL_SetWindowBordered(window.get(), SDL_FALSE);
-						SDL_SetWindowSize(window.get(), 120, 50);
-#ifdef _WIN32
-						setWindowShadow(hwnd, {0, 0, 0, 1});
-#endif
-						scenePtr->setScene("Main");
-					}
+	bool Anya::step() {
+		if (!shouldRun)
+			return false;
+
+		// the trace goes into SDL's queue, so it's polled & merged like real input
+		if (replayerPtr != nullptr)
+			replayerPtr->push(tick);
+		// sleep until an event arrives or the next visible change is due, then drain everything that piled up
+		{
+			PROFILE_ZONE("Wait");
+			pollEvents();
+		}
+		if (recorderPtr != nullptr)
+			recorderPtr->record(tick, events);
+		// a click may change the scene, its enter hook enables the buttons the next event sees
+		{
+			PROFILE_ZONE("Events");
+			for (const auto &event : events)
+				handleEvent(event);
+		}
 
-					if (interfacePtr->cursorInBounds(returnBtn, interfacePtr->getMousePos()) && returnBtn->isEnabled && minimalMode) {
-						minimalMode = false;
-						themesExitBtn->isEnabled = true;
-						SDL_SetWindowBordered(window.get(), SDL_TRUE);
-						SDL_SetWindowSize(window.get(), windowWidth, windowHeight);
-#ifdef _WIN32
-						setWindowShadow(hwnd, {0, 0, 0, 0});
-#endif
-						scenePtr->setScene("Settings-Themes");
-					}
+		// animations & fades move by the clock's time, so a simulated clock drives them too
+		deltaTime = std::chrono::duration<double, std::milli>(clock.tick());
 
-					if (interfacePtr->cursorInBounds(themesExitBtn, interfacePtr->getMousePos()) && themesExitBtn->isEnabled) {
-						scenePtr->setScene("Settings");
-						settingsExitBtn->isEnabled = true;
-						themesExitBtn->isEnabled = false;
-						minimalBtn->isEnabled = false;
-						setBGBtn->isEnabled = false;
-						openFileBtn->isEnabled = false;
-						setTypographyBtn->isEnabled = false;
-						setBGIsPressed = false;
-						setTypographyIsPressed = false;
-					}
-				} break;
-
-				case SDL_KEYDOWN: {
-					switch (ev.key.keysym.sym) {
-						case SDLK_RETURN: {
-							if (setBGIsPressed) {
-								auto &bgColorText = setBGColorBtn->text;
-								// apply the colour to the background and reset the text
-								if (bgColorText.contains(',')) {
-									bgColorText.erase(std::remove(bgColorText.begin(), bgColorText.end(), ','));
-									// delete the duplicate character at the end
-									bgColorText.pop_back();
-									// find the all of the spaces
-									auto first = bgColorText.find_first_of(' ');
-									auto second = bgColorText.find_last_of(' ');
-									// get the positions of the colour values and apply them
-									rVal = std::stoi(bgColorText.substr(0, first));
-									gVal = std::stoi(bgColorText.substr(first, second));
-									bVal = std::stoi(bgColorText.substr(second, bgColorText.back()));
-									// 255 163 210 (demo colour)
-								} else if (bgColorText.contains('#')) {
-									char const *hexVal = bgColorText.c_str();
-									// convert the hex to rgb
-									sscanf_s(hexVal, "#%02x%02x%02x", &rVal, &gVal, &bVal);
-								}
-								setBGColorBtn->text = "Set Color";
-							} else if (setTypographyIsPressed) {
-								typographyStr = dirPath + "assets/" + typographyInputBtn->text;
-								typographyInputBtn->text = "Set Font";
-							}
-						} break;
-
-						case SDLK_c: {
-							if (setBGIsPressed) {
-								if (SDL_GetModState() & KMOD_CTRL)
-									SDL_SetClipboardText(setBGColorBtn->text.c_str());
-							} else if (setTypographyIsPressed) {
-								if (SDL_GetModState() & KMOD_CTRL)
-									SDL_SetClipboardText(typographyInputBtn->text.c_str());
-							}
-						} break;
-
-						case SDLK_v: {
-							if (setBGIsPressed) {
-								if (SDL_GetModState() & KMOD_CTRL)
-									setBGColorBtn->text = SDL_GetClipboardText();
-							} else if (setTypographyIsPressed) {
-								if (SDL_GetModState() & KMOD_CTRL)
-									typographyInputBtn->text = SDL_GetClipboardText();
-							}
-						} break;
+		// upload whatever the worker pool finished decoding
+		{
+			PROFILE_ZONE("Image::update");
+			if (imagePtr->update(renderer.get()) > 0) {
+				needsRedraw = true;
+				checkMemoryBudget();
+			}
+		}
+
+		{
+			PROFILE_ZONE("Scene::update");
+			scenePtr->update(deltaTime.count());
+		}
 
-						case SDLK_BACKSPACE: {
-							if (setBGIsPressed) {
-								if (setBGColorBtn->text.contains("Set Color"))
-									break;
+		{
+			PROFILE_ZONE("UInterface::update");
+			uiIsFading = interfacePtr->update(deltaTime.count());
+			needsRedraw |= uiIsFading;
+		}
 
-								if (setBGColorBtn->text.length() > 0)
-									setBGColorBtn->text.pop_back();
-							} else if (setTypographyIsPressed) {
-								if (typographyInputBtn->text.contains("Set Font"))
-									break;
+		// the displayed time only changes when the minute rolls over
+		const auto minute = std::chrono::floor<std::chrono::minutes>(clock.now());
+		if (minute != lastMinute) {
+			lastMinute = minute;
+			needsRedraw = true;
+			checkMemoryBudget();
+		}
 
-								if (typographyInputBtn->text.length() > 0)
-									typographyInputBtn->text.pop_back();
-							}
-						} break;
-					}
-				} break;
-
-				case SDL_TEXTINPUT: {
-					if (setBGColorBtn->isEnabled || setTypographyBtn->isEnabled) {
-						if (!(SDL_GetModState() & KMOD_CTRL && (ev.text.text[0] == 'c' || ev.text.text[0] == 'C' ||
-													ev.text.text[0] == 'v' || ev.text.text[0] == 'V'))) {
-							if (setBGToColor) {
-								if (setBGColorBtn->text.contains("Set Color"))
-									break;
-
-								setBGColorBtn->text += ev.text.text;
-							} else if (setTypographyIsPressed) {
-								if (typographyInputBtn->text.contains("Set Font"))
-									break;
-
-								typographyInputBtn->text += ev.text.text;
-							}
-						}
-					}
-				} break;
-			}
-			end = std::chrono::steady_clock::now();
-			deltaTime = std::chrono::duration<double, std::milli>(end - begin);
-			begin = end;
+		// input & fades run smooth, minimal mode only has to keep the clock up to date
+		pacer.setTargetRate(!events.empty() || uiIsFading ? activeFPS : (minimalMode ? idleFPS : FPS));
 
-#ifdef _DEBUG
-			const auto getTime = [&](std::chrono::system_clock::time_point time) {
-				return Anya(time).getStream()->str();
-			};
+		// hold the redraw back (getWaitTimeout wakes us up shortly before the deadline) when presenting faster than the target rate,
+		// the rest is slept precisely, vsync paces itself, unpaced runs draw every iteration as fast as they can
+		if (isUnpaced())
+			needsRedraw = true;
+		else if (needsRedraw && !isVSync && !pacer.isDue() && pacer.getTimeToDeadline() <= wakeSlack)
+			pacer.waitForDeadline();
 
-			//std::cout << getTime(std::chrono::system_clock::now()) << '\n';
-#endif
-			// enable these buttons when first layer's buttons are disabled
-			if (scenePtr->getCurrentScene() == scenePtr->findScene("Settings") && !settingsBtn->isEnabled) {
-				settingsExitBtn->isEnabled = true;
-				themesBtn->isEnabled = true;
-				githubBtn->isEnabled = true;
-				calendarBtn->isEnabled = true;
-			}
+		if (needsRedraw && (isVSync || isUnpaced() || pacer.isDue())) {
+			draw();
+			// everything since the last present counts as one frame
+			PROFILE_END_FRAME();
+		}
+		++tick;
 
-			// enable these buttons when the second layer's butons are disabled
-			if (scenePtr->getCurrentScene() == scenePtr->findScene("Settings-Themes") && !themesBtn->isEnabled) {
-				setBGBtn->isEnabled = true;
-				minimalBtn->isEnabled = true;
-				setTypographyBtn->isEnabled = true;
-			}
+		return shouldRun;
+	}
 
-			// when minimalMode is false, we can keep the returnBtn from being clickable through the Settings-Theme layer
-			if (minimalMode) {
-				mainQuitBtn->isEnabled = true;
-				minimizeBtn->isEnabled = true;
-				returnBtn->isEnabled = true;
-			} else {
-				mainQuitBtn->isEnabled = false;
-				minimizeBtn->isEnabled = false;
-				returnBtn->isEnabled = false;
+	uint64_t Anya::getTick() const noexcept {
+		return tick;
+	}
+
+	bool Anya::isReplaying() const noexcept {
+		return replayerPtr != nullptr && !replayerPtr->isFinished();
+	}
+
+	int Anya::getDrawCallCount() const noexcept {
+		return imagePtr != nullptr ? imagePtr->getQueuePtr()->getDrawCallCount() : 0;
+	}
+
+	int Anya::getMissedDeadlines() const noexcept {
+		return pacer.getMissedDeadlines();
+	}
+
+	void Anya::pollEvents() {
+		events.clear();
+
+		SDL_Event ev {};
+		const int hasEvent = isUnpaced() ? SDL_PollEvent(&ev) : SDL_WaitEventTimeout(&ev, getWaitTimeout());
+		if (hasEvent == 0)
+			return;
+
+		do {
+			// the loader only wakes the loop up, its results are picked up by Image::update & aren't input (no redraw, no active rate)
+			if (ev.type == Helper::Loader::getWakeEvent())
+				continue;
+
+			// hovering only needs the latest position, merge motion that isn't separated by anything else
+			if (ev.type == SDL_MOUSEMOTION && !events.empty() && events.back().type == SDL_MOUSEMOTION) {
+				ev.motion.xrel += events.back().motion.xrel;
+				ev.motion.yrel += events.back().motion.yrel;
+				events.back() = ev;
+				continue;
 			}
 
-			imagePtr->getAnimPtr()->update(37, deltaTime.count());
-			interfacePtr->update(&ev, deltaTime.count());
+			events.emplace_back(ev);
+		} while (SDL_PollEvent(&ev) != 0);
+	}
 
-			draw();
+	void Anya::handleEvent(const SDL_Event &ev) {
+		interfacePtr->handleEvent(ev);
+
+		// hovering is picked up by the interface update
+		if (ev.type != SDL_MOUSEMOTION)
+			needsRedraw = true;
+
+		switch (ev.type) {
+			case SDL_QUIT: {
+				shouldRun = false;
+			} break;
+
+			case SDL_DROPFILE: {
+				const std::filesystem::path droppedFile = ev.drop.file;
+				SDL_free(ev.drop.file);
+
+				if (droppedFile.extension() == ".gif" || droppedFile.extension() == ".GIF") {
+					// opened & fitted to the window off-thread, the current background stays until it's ready
+					const SDL_Point size = getBackgroundSize();
+					imagePtr->loadGifAsync(droppedFile.string(), size.x, size.y, [this, path = droppedFile.string()](Helper::IMD img) {
+						if (img == nullptr) {
+							std::cout << "Failed to set background: " << path << '\n';
+							return;
+						}
+
+						backgroundGIF = img;
+						customBackground = nullptr;
+						// the stream replaces the extracted frames
+						if (backgroundAnim >= 0)
+							imagePtr->getAnimPtr()->setSpeed(static_cast<uint32_t>(backgroundAnim), 0.0f);
+						backgroundAnim = -1;
+						needsRedraw = true;
+					});
+				} else {
+					loadBackground(droppedFile.string());
+				}
+			} break;
+
+			case SDL_MOUSEBUTTONDOWN: {
+				// only the topmost enabled button of the shown scene gets the click
+				interfacePtr->click(scenePtr->getCurrentScene(), interfacePtr->getMousePos());
+			} break;
+
+			case SDL_KEYDOWN: {
+				switch (ev.key.keysym.sym) {
+					case SDLK_F3: {
+						showMemory = !showMemory;
+					} break;
+
+					case SDLK_F4: {
+						const auto dumpPath = dirPath + "memory.json";
+						if (Helper::dumpMemory(dumpPath))
+							std::cout << "Memory dumped to " << dumpPath << '\n';
+					} break;
+
+					case SDLK_F5: {
+						const auto tracePath = dirPath + "trace.json";
+						if (Helper::writeTrace(tracePath))
+							std::cout << "Trace written to " << tracePath << '\n';
+						Helper::printPhaseTimings();
+					} break;
+
+					case SDLK_RETURN: {
+						if (setBGIsPressed && setBGToFile) {
+							loadBackground(interfacePtr->getButtonText(openFileBtn));
+							setBGToFile = false;
+							interfacePtr->getButtonText(openFileBtn) = "Open File";
+						} else if (setBGIsPressed) {
+							auto &bgColorText = interfacePtr->getButtonText(setBGColorBtn);
+							// apply the colour to the background and reset the text
+							if (bgColorText.contains(',')) {
+								bgColorText.erase(std::remove(bgColorText.begin(), bgColorText.end(), ','));
+								// delete the duplicate character at the end
+								bgColorText.pop_back();
+								// find the all of the spaces
+								auto first = bgColorText.find_first_of(' ');
+								auto second = bgColorText.find_last_of(' ');
+								// get the positions of the colour values and apply them
+								rVal = std::stoi(bgColorText.substr(0, first));
+								gVal = std::stoi(bgColorText.substr(first, second));
+								bVal = std::stoi(bgColorText.substr(second, bgColorText.back()));
+								// 255 163 210 (demo colour)
+							} else if (bgColorText.contains('#')) {
+								char const *hexVal = bgColorText.c_str();
+								// convert the hex to rgb
+								std::sscanf(hexVal, "#%02x%02x%02x", &rVal, &gVal, &bVal);
+							}
+							interfacePtr->getButtonText(setBGColorBtn) = "Set Color";
+						} else if (setTypographyIsPressed) {
+							// keep the current font when the new one can't be mapped
+							const auto fontFile = dirPath + "assets/" + interfacePtr->getButtonText(typographyInputBtn);
+							if (imagePtr->getFontPtr()->load(fontFile))
+								typographyStr = fontFile;
+							else
+								std::cout << "Failed to set font: " << fontFile << '\n';
+							interfacePtr->getButtonText(typographyInputBtn) = "Set Font";
+						}
+					} break;
+
+					case SDLK_c: {
+						if (setBGIsPressed) {
+							if (SDL_GetModState() & KMOD_CTRL)
+								SDL_SetClipboardText(interfacePtr->getButtonText(setBGColorBtn).c_str());
+						} else if (setTypographyIsPressed) {
+							if (SDL_GetModState() & KMOD_CTRL)
+								SDL_SetClipboardText(interfacePtr->getButtonText(typographyInputBtn).c_str());
+						}
+					} break;
+
+					case SDLK_v: {
+						if (setBGIsPressed && setBGToFile) {
+							if (SDL_GetModState() & KMOD_CTRL)
+								interfacePtr->getButtonText(openFileBtn) = SDL_GetClipboardText();
+						} else if (setBGIsPressed) {
+							if (SDL_GetModState() & KMOD_CTRL)
+								interfacePtr->getButtonText(setBGColorBtn) = SDL_GetClipboardText();
+						} else if (setTypographyIsPressed) {
+							if (SDL_GetModState() & KMOD_CTRL)
+								interfacePtr->getButtonText(typographyInputBtn) = SDL_GetClipboardText();
+						}
+					} break;
+
+					case SDLK_BACKSPACE: {
+						if (setBGIsPressed && setBGToFile) {
+							if (interfacePtr->getButtonText(openFileBtn).length() > 0)
+								interfacePtr->getButtonText(openFileBtn).pop_back();
+						} else if (setBGIsPressed) {
+							if (interfacePtr->getButtonText(setBGColorBtn).contains("Set Color"))
+								break;
+
+							if (interfacePtr->getButtonText(setBGColorBtn).length() > 0)
+								interfacePtr->getButtonText(setBGColorBtn).pop_back();
+						} else if (setTypographyIsPressed) {
+							if (interfacePtr->getButtonText(typographyInputBtn).contains("Set Font"))
+								break;
+
+							if (interfacePtr->getButtonText(typographyInputBtn).length() > 0)
+								interfacePtr->getButtonText(typographyInputBtn).pop_back();
+						}
+					} break;
+				}
+			} break;
+
+			case SDL_TEXTINPUT: {
+				if (interfacePtr->isButtonEnabled(setBGColorBtn) || interfacePtr->isButtonEnabled(setTypographyBtn)) {
+					if (!(SDL_GetModState() & KMOD_CTRL && (ev.text.text[0] == 'c' || ev.text.text[0] == 'C' ||
+												ev.text.text[0] == 'v' || ev.text.text[0] == 'V'))) {
+						if (setBGToFile) {
+							interfacePtr->getButtonText(openFileBtn) += ev.text.text;
+						} else if (setBGToColor) {
+							if (interfacePtr->getButtonText(setBGColorBtn).contains("Set Color"))
+								break;
+
+							interfacePtr->getButtonText(setBGColorBtn) += ev.text.text;
+						} else if (setTypographyIsPressed) {
+							if (interfacePtr->getButtonText(typographyInputBtn).contains("Set Font"))
+								break;
+
+							interfacePtr->getButtonText(typographyInputBtn) += ev.text.text;
+						}
+					}
+				}
+			} break;
 		}
-		free();
 	}
 
 	// usually you want this to be independent
 	void Anya::draw() {
+		pacer.beginFrame();
+		PROFILE_ZONE("Draw");
+
 		SDL_SetRenderDrawBlendMode(renderer.get(), SDL_BLENDMODE_BLEND);
 		SDL_SetRenderDrawColor(renderer.get(), 255, 0, 0, 255);
 		SDL_RenderClear(renderer.get());
-		
-		if (scenePtr->getCurrentScene() == scenePtr->findScene("Main")) {
-			timeText = imagePtr->createTextA({timeToStr(std::chrono::system_clock::now()), typographyStr, {{0}, {0}, {255, 255, 255}}, 28}, renderer.get());
-			dateText = imagePtr->createTextA({std::format("{:%Ex}", std::chrono::current_zone()->to_local(std::chrono::system_clock::now())), dirPath + "assets/Onest.ttf", {{0}, {0}, {255, 255, 255}}, 16}, renderer.get());
-			settingsText = imagePtr->createText({settingsBtn->text, dirPath + "assets/Onest.ttf", settingsBtn->buttonColor, 96}, renderer.get());
-
-			if (setBGToColor) {
-				SDL_SetRenderDrawColor(renderer.get(), rVal, gVal, bVal, 255);
-				SDL_RenderFillRect(renderer.get(), &fillBGColor);
-			} else {
-				imagePtr->drawAnimation(backgroundGIF, renderer.get(), 0, 0);
-			}
 
-			if (minimalMode) {
-				mainQuitText = imagePtr->createText({mainQuitBtn->text, dirPath + "assets/Onest.ttf", mainQuitBtn->buttonColor, 96}, renderer.get());
-				minimizeText = imagePtr->createText({minimizeBtn->text, dirPath + "assets/Onest.ttf", minimizeBtn->buttonColor, 96}, renderer.get());
+		// everything below is batched, the queue is submitted when the frame is presented
+		auto &queue = *imagePtr->getQueuePtr();
+
+		// the shown scene submits its quads
+		scenePtr->draw();
+
+		if (showMemory)
+			drawMemoryOverlay();
+
+		{
+			PROFILE_ZONE("Present");
+			queue.present(renderer.get());
+		}
+
+		needsRedraw = false;
+		pacer.endFrame();
+	}
+
+	void Anya::drawMainScene() {
+		auto &queue = *imagePtr->getQueuePtr();
+
+		const auto now = clock.now();
+		imagePtr->createTextA({timeToStr(now), typographyStr, {{0}, {0}, {255, 255, 255}}, 28}, renderer.get(), timeText);
+		imagePtr->createTextA({timeFormat.date(now), fontPath, {{0}, {0}, {255, 255, 255}}, 16}, renderer.get(), dateText);
+		imagePtr->createText({interfacePtr->getButtonText(settingsBtn), fontPath, interfacePtr->getButtonTheme(settingsBtn), 96}, renderer.get(), settingsText);
+
+		if (setBGToColor) {
+			queue.fillRect(renderer.get(), fillBGColor, {static_cast<uint8_t>(rVal), static_cast<uint8_t>(gVal), static_cast<uint8_t>(bVal), 255});
+		} else if (customBackground != nullptr) {
+			queue.copy(renderer.get(), customBackground->texture.get(), nullptr, fillBGColor);
+		} else {
+			if (backgroundAnim >= 0)
+				imagePtr->drawAnimation(static_cast<uint32_t>(backgroundAnim), renderer.get(), 0, 0);
+			else
+				imagePtr->drawAnimation(backgroundGIF, renderer.get(), fillBGColor);
+		}
+
+		if (minimalMode) {
+			imagePtr->createText({interfacePtr->getButtonText(mainQuitBtn), fontPath, interfacePtr->getButtonTheme(mainQuitBtn), 96}, renderer.get(), mainQuitText);
+			imagePtr->createText({interfacePtr->getButtonText(minimizeBtn), fontPath, interfacePtr->getButtonTheme(minimizeBtn), 96}, renderer.get(), minimizeText);
 
-				SDL_SetRenderDrawColor(renderer.get(), 0, 0, 0, 255);
-				SDL_RenderFillRect(renderer.get(), &fillBGColor);
+			queue.fillRect(renderer.get(), fillBGColor, {0, 0, 0, 255});
 
-				imagePtr->draw(timeText, renderer.get(), 0, 18);
+			imagePtr->draw(timeText, renderer.get(), 0, 18);
 
-				interfacePtr->setButtonTextSize(mainQuitText, -2, 0);
-				interfacePtr->draw(mainQuitBtn, mainQuitText, renderer.get());
-				interfacePtr->draw(minimizeBtn, minimizeText, renderer.get());
-				interfacePtr->draw(returnBtn, nullptr, renderer.get());
+			interfacePtr->setButtonTextSize(mainQuitText, -2, 0);
+			interfacePtr->draw(mainQuitBtn, mainQuitText, renderer.get());
+			interfacePtr->draw(minimizeBtn, minimizeText, renderer.get());
+			interfacePtr->draw(returnBtn, nullptr, renderer.get());
+		} else {
+			if (showDate) {
+				imagePtr->draw(timeText, renderer.get(), static_cast<int>(windowWidth / 10), static_cast<int>(windowHeight / 1.6));
+				imagePtr->draw(dateText, renderer.get(), static_cast<int>(windowWidth / 4), static_cast<int>(windowHeight / 2.1));
 			} else {
-				if (showDate) {
-					imagePtr->draw(timeText, renderer.get(), static_cast<int>(windowWidth / 10), static_cast<int>(windowHeight / 1.6));
-					imagePtr->draw(dateText, renderer.get(), static_cast<int>(windowWidth / 4), static_cast<int>(windowHeight / 2.1));
-				} else {
-					imagePtr->draw(timeText, renderer.get(), static_cast<int>(windowWidth / 10), static_cast<int>(windowHeight / 1.6));
-				}
-				// put the settings button in non minimal mode for now, resize & set button pos for minimal mode later
-				interfacePtr->setButtonTextSize(settingsText, 1, 16);
-				interfacePtr->draw(settingsBtn, settingsText, renderer.get());
+				imagePtr->draw(timeText, renderer.get(), static_cast<int>(windowWidth / 10), static_cast<int>(windowHeight / 1.6));
 			}
+			// put the settings button in non minimal mode for now, resize & set button pos for minimal mode later
+			interfacePtr->setButtonTextSize(settingsText, 1, 16);
+			interfacePtr->draw(settingsBtn, settingsText, renderer.get());
 		}
+	}
+
+	void Anya::drawSettingsScene() {
+		auto &queue = *imagePtr->getQueuePtr();
 
-		if (scenePtr->getCurrentScene() == scenePtr->findScene("Settings")) {
-			settingsExitText = imagePtr->createText({settingsExitBtn->text, dirPath + "assets/Onest.ttf", settingsExitBtn->buttonColor, 72}, renderer.get());
-			themesText = imagePtr->createText({themesBtn->text, dirPath + "assets/Onest.ttf", themesBtn->buttonColor, 32}, renderer.get());
-			quitText = imagePtr->createText({settingsQuitBtn->text, dirPath + "assets/Onest.ttf", settingsQuitBtn->buttonColor, 96}, renderer.get());
-			// brown background colour
-			SDL_SetRenderDrawColor(renderer.get(), 26, 17, 16, 255);
-			SDL_RenderFillRect(renderer.get(), &settingsView);
-
-			interfacePtr->draw(settingsExitBtn, settingsExitText, renderer.get());
-			interfacePtr->draw(settingsQuitBtn, quitText, renderer.get());
-			interfacePtr->draw(githubBtn, nullptr, renderer.get());
-			interfacePtr->draw(themesBtn, themesText, renderer.get());
-			interfacePtr->draw(calendarBtn, nullptr, renderer.get());
+		imagePtr->createText({interfacePtr->getButtonText(settingsExitBtn), fontPath, interfacePtr->getButtonTheme(settingsExitBtn), 72}, renderer.get(), settingsExitText);
+		imagePtr->createText({interfacePtr->getButtonText(themesBtn), fontPath, interfacePtr->getButtonTheme(themesBtn), 32}, renderer.get(), themesText);
+		imagePtr->createText({interfacePtr->getButtonText(settingsQuitBtn), fontPath, interfacePtr->getButtonTheme(settingsQuitBtn), 96}, renderer.get(), quitText);
+		// brown background colour
+		queue.fillRect(renderer.get(), settingsView, {26, 17, 16, 255});
+
+		interfacePtr->draw(settingsExitBtn, settingsExitText, renderer.get());
+		interfacePtr->draw(settingsQuitBtn, quitText, renderer.get());
+		interfacePtr->draw(githubBtn, nullptr, renderer.get());
+		interfacePtr->draw(themesBtn, themesText, renderer.get());
+		interfacePtr->draw(calendarBtn, nullptr, renderer.get());
+	}
+
+	void Anya::drawSettingsThemesScene() {
+		auto &queue = *imagePtr->getQueuePtr();
+
+		imagePtr->createText({interfacePtr->getButtonText(themesExitBtn), fontPath, interfacePtr->getButtonTheme(themesExitBtn), 96}, renderer.get(), themesExitText);
+		imagePtr->createText({interfacePtr->getButtonText(minimalBtn), fontPath, interfacePtr->getButtonTheme(minimalBtn), 96}, renderer.get(), minimalText);
+		imagePtr->createText({interfacePtr->getButtonText(setBGBtn), fontPath, interfacePtr->getButtonTheme(setBGBtn), 96}, renderer.get(), setBGText);
+		// brown background colour
+		queue.fillRect(renderer.get(), settingsThemesView, {26, 17, 16, 255});
+
+		interfacePtr->draw(themesExitBtn, themesExitText, renderer.get());
+		interfacePtr->draw(minimalBtn, minimalText, renderer.get());
+		interfacePtr->draw(setBGBtn, setBGText, renderer.get());
+		interfacePtr->draw(setTypographyBtn, nullptr, renderer.get());
+		interfacePtr->draw(setThemeBtn, nullptr, renderer.get());
+
+		if (setTypographyIsPressed) {
+			imagePtr->createText({interfacePtr->getButtonText(typographyInputBtn), fontPath, interfacePtr->getButtonTheme(openFileBtn), 96}, renderer.get(), typographyInputText);
+
+			interfacePtr->setButtonTextSize(typographyInputText, -45, 2);
+			interfacePtr->draw(typographyInputBtn, typographyInputText, renderer.get());
 		}
 
-		if (scenePtr->getCurrentScene() == scenePtr->findScene("Settings-Themes")) {
-			themesExitText = imagePtr->createText({themesExitBtn->text, dirPath + "assets/Onest.ttf", themesExitBtn->buttonColor, 96}, renderer.get());
-			minimalText = imagePtr->createText({minimalBtn->text, dirPath + "assets/Onest.ttf", minimalBtn->buttonColor, 96}, renderer.get());
-			setBGText = imagePtr->createText({setBGBtn->text, dirPath + "assets/Onest.ttf", setBGBtn->buttonColor, 96}, renderer.get());
-			// brown background colour
-			SDL_SetRenderDrawColor(renderer.get(), 26, 17, 16, 255);
-			SDL_RenderFillRect(renderer.get(), &settingsThemesView);
-
-			interfacePtr->draw(themesExitBtn, themesExitText, renderer.get());
-			interfacePtr->draw(minimalBtn, minimalText, renderer.get());
-			interfacePtr->draw(setBGBtn, setBGText, renderer.get());
-			interfacePtr->draw(setTypographyBtn, nullptr, renderer.get());
-			interfacePtr->draw(setThemeBtn, nullptr, renderer.get());
-
-			if (setTypographyIsPressed) {
-				typographyInputText = imagePtr->createText({typographyInputBtn->text, dirPath + "assets/Onest.ttf", openFileBtn->buttonColor, 96}, renderer.get());
-
-				interfacePtr->setButtonTextSize(typographyInputText, -45, 2);
-				interfacePtr->draw(typographyInputBtn, typographyInputText, renderer.get());
-			}
+		if (setBGIsPressed) {
+			imagePtr->createText({interfacePtr->getButtonText(openFileBtn), fontPath, interfacePtr->getButtonTheme(openFileBtn), 96}, renderer.get(), openFileText);
+			imagePtr->createText({interfacePtr->getButtonText(setBGColorBtn), fontPath, interfacePtr->getButtonTheme(setBGColorBtn), 28}, renderer.get(), setBGColorText);
+
+			interfacePtr->draw(openFileBtn, openFileText, renderer.get());
+			interfacePtr->draw(setBGColorBtn, setBGColorText, renderer.get());
+		}
+	}
+
+	void Anya::drawMemoryOverlay() {
+		const auto toMB = [](int64_t bytes) {return static_cast<double>(bytes) / (1024.0 * 1024.0);};
+		const auto getTotal = [](Helper::MemoryKind kind) {
+			int64_t bytes = 0;
+			for (size_t tag = 0; tag < static_cast<size_t>(Helper::MemoryTag::Count); ++tag)
+				bytes += Helper::getMemoryUsage(kind, static_cast<Helper::MemoryTag>(tag)).bytes;
+			return bytes;
+		};
+
+		// formatted into the same buffer every frame, it keeps its capacity
+		overlayStr.clear();
+		std::format_to(std::back_inserter(overlayStr), "tex {:.1f} heap {:.1f} mb", toMB(getTotal(Helper::MemoryKind::Texture)), toMB(getTotal(Helper::MemoryKind::Heap)));
+		const SDL_Color color = isOverBudget ? SDL_Color {255, 80, 80, 255} : SDL_Color {255, 255, 255, 255};
+		imagePtr->createText({overlayStr, fontPath, {{0}, {0}, color}, 10}, renderer.get(), memoryText);
+
+		// the frame being drawn isn't submitted yet, the last presented one is shown
+		overlayStr.clear();
+		std::format_to(std::back_inserter(overlayStr), "draws {} missed {}", getDrawCallCount(), getMissedDeadlines());
+		imagePtr->createText({overlayStr, fontPath, {{0}, {0}, {255, 255, 255}}, 10}, renderer.get(), frameText);
+
+		auto &queue = *imagePtr->getQueuePtr();
+		const SDL_Rect background {0, static_cast<int>(windowHeight) - 24, static_cast<int>(windowWidth), 24};
+		queue.fillRect(renderer.get(), background, {0, 0, 0, 191});
+		imagePtr->draw(frameText, renderer.get(), 2, background.y);
+		imagePtr->draw(memoryText, renderer.get(), 2, background.y + 12);
+	}
+
+	void Anya::checkMemoryBudget() {
+		const bool wasOverBudget = isOverBudget;
+		isOverBudget = Helper::isOverMemoryBudget();
+		if (isOverBudget) {
+			// cached images nothing draws right now go first, they are decoded again if they're needed
+			auto &cache = imagePtr->getCache();
+			const auto over = static_cast<size_t>(Helper::getMemoryTotal() - Helper::getMemoryBudget());
+			const size_t cached = cache.getStats().bytes;
+			cache.trim(cached > over ? cached - over : 0);
+			isOverBudget = Helper::isOverMemoryBudget();
+		}
+
+		if (isOverBudget && !wasOverBudget)
+			std::cout << "Over the memory budget (" << Helper::getMemoryTotal() << "/" << Helper::getMemoryBudget() << " bytes): " << Helper::dumpMemory() << '\n';
+	}
+
+	SDL_Point Anya::getBackgroundSize() const {
+		// cover the window in output pixels, high DPI outputs are larger than the window
+		int outputWidth = 0;
+		int outputHeight = 0;
+		int currentWidth = 0;
+		int currentHeight = 0;
+		SDL_GetWindowSize(window.get(), &currentWidth, &currentHeight);
+		const bool hasOutput = SDL_GetRendererOutputSize(renderer.get(), &outputWidth, &outputHeight) == 0 && currentWidth > 0 && currentHeight > 0;
+		const double scaleX = hasOutput ? static_cast<double>(outputWidth) / currentWidth : 1.0;
+		const double scaleY = hasOutput ? static_cast<double>(outputHeight) / currentHeight : 1.0;
+
+		return {static_cast<int>(std::ceil(windowWidth * scaleX)), static_cast<int>(std::ceil(windowHeight * scaleY))};
+	}
+
+	void Anya::loadBackground(std::string_view filePath) {
+		// typed names are looked up next to the assets like fonts
+		std::basic_string<char> path {filePath};
+		if (!std::filesystem::exists(path) && std::filesystem::exists(dirPath + "assets/" + path))
+			path = dirPath + "assets/" + path;
 
-			if (setBGIsPressed) {
-				openFileText = imagePtr->createText({openFileBtn->text, dirPath + "assets/Onest.ttf", openFileBtn->buttonColor, 96}, renderer.get());
-				setBGColorText = imagePtr->createText({setBGColorBtn->text, dirPath + "assets/Onest.ttf", setBGColorBtn->buttonColor, 28}, renderer.get());
+		// a single decode at a time keeps the peak to one image, only the latest choice is kept waiting
+		if (isLoadingBackground) {
+			pendingBackground = path;
+			return;
+		}
+		isLoadingBackground = true;
+
+		const SDL_Point size = getBackgroundSize();
+		imagePtr->loadFittedAsync(path, size.x, size.y, [this, path](Helper::IMD img) {
+			isLoadingBackground = false;
 
-				interfacePtr->draw(openFileBtn, openFileText, renderer.get());
-				interfacePtr->draw(setBGColorBtn, setBGColorText, renderer.get());
+			// a newer choice replaces this one before it's ever shown
+			if (!pendingBackground.empty()) {
+				loadBackground(std::exchange(pendingBackground, {}));
+				return;
 			}
+
+			if (img == nullptr) {
+				std::cout << "Failed to set background: " << path << '\n';
+				return;
+			}
+
+			customBackground = img;
+			setBGToColor = false;
+			needsRedraw = true;
+		});
+	}
+
+	int Anya::getWaitTimeout() const {
+		const auto now = clock.now();
+		double timeout = std::chrono::duration<double, std::milli>(std::chrono::floor<std::chrono::minutes>(now) + std::chrono::minutes(1) - now).count();
+
+		const double period = std::chrono::duration<double, std::milli>(pacer.getPeriod()).count();
+		if (uiIsFading)
+			timeout = std::min(timeout, period);
+
+		if (isGIFVisible())
+			timeout = std::min(timeout, imagePtr->getAnimPtr()->getTimeToNextFrame());
+
+		// a redraw that was held back to keep to the frame rate, wake up early & let the pacer sleep the rest precisely
+		if (needsRedraw && !isVSync) {
+			const auto untilDeadline = std::chrono::duration<double, std::milli>(pacer.getTimeToDeadline() - wakeSlack).count();
+			return static_cast<int>(std::ceil(std::max(std::min(timeout, untilDeadline), 0.0)));
 		}
-		
-		SDL_RenderPresent(renderer.get());
 
-		if (delay > deltaTime.count())
-			SDL_Delay(delay - static_cast<int>(deltaTime.count()));
+		return static_cast<int>(std::ceil(std::max(timeout, 0.0)));
+	}
+
+	bool Anya::isGIFVisible() const {
+		return scenePtr->getCurrentScene() == Helper::SceneID::Main && !setBGToColor && !minimalMode && customBackground == nullptr;
 	}
 
 	void Anya::free() {
 		std::cout << "releasing allocated resources..\n";
+#ifdef TIME_PROFILE
+		// only when the app got to run
+		if (imagePtr != nullptr) {
+			Helper::writeTrace(dirPath + "trace.json");
+			Helper::printPhaseTimings();
+		}
+#endif
+		// the trace is closed with the session
+		recorderPtr.reset();
+		replayerPtr.reset();
+		// fonts & textures have to be released before their subsystems shut down
+		interfacePtr.reset();
+		imagePtr.reset();
 		SDL_StopTextInput();
 		TTF_Quit();
 		IMG_Quit();
 		SDL_Quit();
 	}
 
-	std::basic_string<char> Anya::timeToStr(const std::chrono::system_clock::time_point &time) {
-		// convert time_point to a useable hour
-		struct tm localTime;
-		time_t currentTime = std::chrono::system_clock::to_time_t(time);
-		localtime_s(&localTime, &currentTime);
+	std::string_view Anya::timeToStr(const std::chrono::system_clock::time_point &time) {
+		return timeFormat.time(time);
+	}
+
+	void Anya::setClock(Helper::Clock newClock) {
+		clock = std::move(newClock);
+		// the minute changed as far as the new clock is concerned
+		lastMinute = {};
+	}
 
-		auto hour = std::chrono::hours(localTime.tm_hour);
+	const Helper::Clock &Anya::getClock() const noexcept {
+		return clock;
+	}
 
-		if (std::chrono::is_pm(hour)) {
-			return std::format("{:%OI:%M}PM", std::chrono::current_zone()->to_local(time));
-		} else {
-			return std::format("{:%OI:%M}AM", std::chrono::current_zone()->to_local(time));
-		}
+	std::string_view Anya::getDisplayedTime() const noexcept {
+		return timeText.text;
 	}
 
-	std::unique_ptr<std::basic_stringstream<char>> Anya::getStream() {
-		auto ptr = std::make_unique<std::basic_stringstream<char>>(std::move(str));
-		return ptr;
+	bool Anya::isUnpaced() const noexcept {
+		return launchOptions.unpaced || !clock.isRealTime();
 	}
 } // namespace Application
\ No newline at end of file
@@ -1,13 +1,19 @@
 #pragma once
 
 #include <SDL.h>
+#include "backend.hpp"
+#include "clock.hpp"
 #include "image.hpp"
+#include "pacer.hpp"
+#include "profiler.hpp"
+#include "recorder.hpp"
 #include "uinterface.hpp"
 #include "util.hpp"
 #include "scene.hpp"
+#include "timeformat.hpp"
 #include <chrono>
 #include <format>
-#include <sstream>
+#include <vector>
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <dwmapi.h>
@@ -16,49 +22,113 @@
 #endif
 
 // low memory | low cpu utilization app (not the lowest since added features and no optimizations)
-// at its current state, it takes 3.6mb on debug, too high. (11mb with gif alloc)
+// memory is measured by memstats.hpp, F3 shows it on screen (with the draw calls & missed deadlines) & F4 dumps it (memory.json next to the executable)
+// frames are profiled by profiler.hpp in debug builds, F5 & exiting write trace.json & print the p50/p99 of every phase
+// sessions can be recorded & replayed (--record=<file> / --replay=<file>), tools/bench.cpp replays them headless
+// every time the app reads comes from its Clock, --clock=fixed (or setClock) runs simulated time as fast as it can (tools/clocksim.cpp)
 
 namespace Application {
 	using namespace Helper::Utilities;
 
 	class Anya final {
 	public:
-		Anya();
-#ifdef _DEBUG
-		Anya(const std::chrono::system_clock::time_point &time);
-#endif
+		/** Boot & run the app.
+		 *
+		 * \param argc -> the argument count of main
+		 * \param argv -> the arguments of main (see backend.hpp for the options)
+		 * \param shouldLoop -> boot & run until quit, otherwise the caller boots & steps the loop itself
+		 */
+		Anya(int argc = 0, char **argv = nullptr, bool shouldLoop = true);
 
-		std::basic_string<char> timeToStr(const std::chrono::system_clock::time_point &time);
-		std::unique_ptr<std::basic_stringstream<char>> getStream();
+		std::string_view timeToStr(const std::chrono::system_clock::time_point &time);
+		// replaces the clock (the next tick is measured from the new clock)
+		void setClock(Helper::Clock newClock);
+		const Helper::Clock &getClock() const noexcept;
+		// the time of the last drawn frame
+		std::string_view getDisplayedTime() const noexcept;
 		bool boot();
+		// runs the loop until quit, then frees everything
 		void update();
+		// a single iteration of the loop, returns false once the app quit
+		bool step();
+		uint64_t getTick() const noexcept;
+		bool isReplaying() const noexcept;
+		// SDL_RenderGeometry calls of the last presented frame
+		int getDrawCallCount() const noexcept;
+		// frames that finished after their deadline since boot
+		int getMissedDeadlines() const noexcept;
 		void draw();
 		void free();
 
+	private:
+		// wait for the first event & drain the rest of the queue into events
+		void pollEvents();
+		void handleEvent(const SDL_Event &ev);
+		// the draw hooks of the scenes
+		void drawMainScene();
+		void drawSettingsScene();
+		void drawSettingsThemesScene();
+		void drawMemoryOverlay();
+		// evict cached textures when over the budget, warn once every time that isn't enough
+		void checkMemoryBudget();
+		// the size (output pixels) user backgrounds are fitted to
+		SDL_Point getBackgroundSize() const;
+		// decode & fit a user image off-thread, the current background stays until it's ready
+		void loadBackground(std::string_view filePath);
+		// how long the loop can sleep before something on screen has to change
+		int getWaitTimeout() const;
+		bool isGIFVisible() const;
+		// simulated time isn't waited for
+		bool isUnpaced() const noexcept;
+
 	private:
 		// window data
 		std::basic_string<char> title {"anya"};
 		std::basic_string<char> errStr {};
 		PTR<SDL_Window> window {nullptr};
 		PTR<SDL_Renderer> renderer {nullptr};
-		SDL_Event ev {};
+		Helper::LaunchOptions launchOptions {};
+		// presenting blocks until the display refreshes, so draws don't have to be held back
+		bool isVSync {false};
+		// everything that arrived since the last iteration (consecutive mouse motion merged)
+		std::vector<SDL_Event> events {};
+		// loop iterations since boot, traces are replayed by it
+		uint64_t tick {0};
+		std::unique_ptr<Helper::EventRecorder> recorderPtr {nullptr};
+		std::unique_ptr<Helper::EventReplayer> replayerPtr {nullptr};
 		bool shouldRun {false};
 		uint32_t windowWidth {148};
 		uint32_t windowHeight {89};
-		std::chrono::steady_clock::time_point begin {};
-		std::chrono::steady_clock::time_point end {};
+		Helper::Clock clock {};
 		std::chrono::duration<double, std::milli> deltaTime {};
-		int FPS {30};
-		const int delay {1000 / FPS};
+		// target rates: while something moves / the default / minimal mode (only the clock changes)
+		double activeFPS {60.0};
+		double FPS {30.0};
+		double idleFPS {1.0};
+		Helper::FramePacer pacer {FPS};
+		// SDL_WaitEventTimeout only has millisecond resolution, the pacer sleeps the last part
+		const std::chrono::milliseconds wakeSlack {2};
+		// how long each pre-extracted gif frame is shown (ms)
+		const float animSpeed {37.0f};
+		// the animation instance playing the pre-extracted frames, -1 when the gif is streamed
+		int backgroundAnim {-1};
+		// redraw only when the frame would differ from what is presented
+		bool needsRedraw {true};
+		bool uiIsFading {false};
+		std::chrono::sys_time<std::chrono::minutes> lastMinute {};
 
 	private:
 		std::unique_ptr<Helper::UInterface> interfacePtr {nullptr};
 		std::unique_ptr<Helper::Image> imagePtr {nullptr};
 		std::unique_ptr<Helper::Scene> scenePtr {nullptr};
+		Helper::TimeFormat timeFormat {};
 		// directory path
 		std::basic_string<char> dirPath {};
+		// the ui font & the clock font (set from the typography input), built once instead of every frame
+		std::basic_string<char> fontPath {};
 		std::basic_string<char> typographyStr {};
-		std::basic_stringstream<char> str {};
+		// the F3 overlay lines are formatted into this
+		std::basic_string<char> overlayStr {};
 		// set background colour
 		int rVal {0};
 		int gVal {0};
@@ -69,8 +139,20 @@ namespace Application {
 		bool setBGIsPressed {false};
 		// setBGColor button on/off
 		bool setBGToColor {false};
+		// typing goes to the openFile button (a path)
+		bool setBGToFile {false};
+		// a user background is decoding, the latest one chosen meanwhile waits in pendingBackground
+		bool isLoadingBackground {false};
+		std::basic_string<char> pendingBackground {};
 		bool minimalMode {false};
 		bool showDate {false};
+		// memory & frame overlay (F3)
+		bool showMemory {false};
+		// textures, surfaces & heap together, the texture cache is trimmed & the rest reported when exceeded
+		const int64_t memoryBudget {32 * 1024 * 1024};
+		// the share the texture cache keeps of it for images that aren't drawn right now
+		const int64_t cacheBudget {memoryBudget / 2};
+		bool isOverBudget {false};
 
 		float sceneAlpha {SDL_ALPHA_TRANSPARENT};
 
@@ -84,27 +166,31 @@ namespace Application {
 
 		Helper::IMD backgroundGIF {nullptr};
 		Helper::IMD backgroundImg {nullptr};
+		// the user's image, fitted to the window (drawn instead of the gif)
+		Helper::IMD customBackground {nullptr};
 		Helper::IMD githubImg {nullptr};
 		Helper::IMD calendarImg {nullptr};
 		Helper::IMD typographyImg {nullptr};
 		Helper::IMD returnImg {nullptr};
 		Helper::IMD setThemeImg {nullptr};
 		// text
-		Helper::IMD timeText {nullptr};
-		Helper::IMD dateText {nullptr};
-		Helper::IMD settingsText {nullptr};
-		Helper::IMD mainQuitText {nullptr};
-		Helper::IMD minimizeText {nullptr};
-		Helper::IMD quitText {nullptr};
-		Helper::IMD settingsExitText {nullptr};
-		Helper::IMD themesText {nullptr};
-		Helper::IMD themesExitText {nullptr};
-		// Helper::IMD setLayoutText {nullptr};
-		Helper::IMD minimalText {nullptr};
-		Helper::IMD setBGText {nullptr};
-		Helper::IMD openFileText {nullptr};
-		Helper::IMD setBGColorText {nullptr};
-		Helper::IMD typographyInputText {nullptr};
+		Helper::TextRun timeText {};
+		Helper::TextRun dateText {};
+		Helper::TextRun settingsText {};
+		Helper::TextRun mainQuitText {};
+		Helper::TextRun minimizeText {};
+		Helper::TextRun quitText {};
+		Helper::TextRun settingsExitText {};
+		Helper::TextRun themesText {};
+		Helper::TextRun themesExitText {};
+		// Helper::TextRun setLayoutText {};
+		Helper::TextRun minimalText {};
+		Helper::TextRun setBGText {};
+		Helper::TextRun openFileText {};
+		Helper::TextRun setBGColorText {};
+		Helper::TextRun typographyInputText {};
+		Helper::TextRun memoryText {};
+		Helper::TextRun frameText {};
 		// test button theme changing
 		/*
 		Helper::IMD themesOCText {nullptr};
@@ -113,33 +199,33 @@ namespace Application {
 		*/
 
 		// buttons
-		Helper::BUTTONPTR settingsBtn {nullptr};
-		Helper::BUTTONPTR mainQuitBtn {nullptr};
-		Helper::BUTTONPTR minimizeBtn {nullptr};
-		Helper::BUTTONPTR returnBtn {nullptr};
-		Helper::BUTTONPTR settingsQuitBtn {nullptr};
-		Helper::BUTTONPTR settingsExitBtn {nullptr};
-		Helper::BUTTONPTR themesBtn {nullptr};
-		Helper::BUTTONPTR githubBtn {nullptr};
-		Helper::BUTTONPTR calendarBtn {nullptr};
-		//Helper::BUTTONPTR setLayoutBtn {nullptr};
-		Helper::BUTTONPTR themesExitBtn {nullptr};
-		Helper::BUTTONPTR minimalBtn {nullptr};
-		Helper::BUTTONPTR setBGBtn {nullptr};
-		Helper::BUTTONPTR openFileBtn {nullptr};
-		Helper::BUTTONPTR setBGColorBtn {nullptr};
-		Helper::BUTTONPTR setTypographyBtn {nullptr};
-		Helper::BUTTONPTR typographyInputBtn {nullptr};
-		Helper::BUTTONPTR setThemeBtn {nullptr};
-		//Helper::BUTTONPTR setMenuBGBtn {nullptr};
+		Helper::ButtonHandle settingsBtn {};
+		Helper::ButtonHandle mainQuitBtn {};
+		Helper::ButtonHandle minimizeBtn {};
+		Helper::ButtonHandle returnBtn {};
+		Helper::ButtonHandle settingsQuitBtn {};
+		Helper::ButtonHandle settingsExitBtn {};
+		Helper::ButtonHandle themesBtn {};
+		Helper::ButtonHandle githubBtn {};
+		Helper::ButtonHandle calendarBtn {};
+		//Helper::ButtonHandle setLayoutBtn {};
+		Helper::ButtonHandle themesExitBtn {};
+		Helper::ButtonHandle minimalBtn {};
+		Helper::ButtonHandle setBGBtn {};
+		Helper::ButtonHandle openFileBtn {};
+		Helper::ButtonHandle setBGColorBtn {};
+		Helper::ButtonHandle setTypographyBtn {};
+		Helper::ButtonHandle typographyInputBtn {};
+		Helper::ButtonHandle setThemeBtn {};
+		//Helper::ButtonHandle setMenuBGBtn {};
 		// test button theme changing
 		/*
-		Helper::BUTTONPTR setButtonOCBtn {nullptr};
-		Helper::BUTTONPTR setButtonBGBtn {nullptr};
-		Helper::BUTTONPTR setButtonTCBtn {nullptr};
+		Helper::ButtonHandle setButtonOCBtn {};
+		Helper::ButtonHandle setButtonBGBtn {};
+		Helper::ButtonHandle setButtonTCBtn {};
 		// reuse input button for each button colour
 		// set the enter key to submit the value based on the button selected
-		Helper::BUTTONPTR buttonColorInputBtn {nullptr};
+		Helper::ButtonHandle buttonColorInputBtn {};
 		*/
 	};
 } // namespace Application
@@ -0,0 +1,206 @@
+#include "atlas.hpp"
+#include "util.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace Application::Helper {
+	Atlas::Atlas(SDL_Renderer *ren, int pageSize, int padding) : pageWidth(pageSize), pageHeight(pageSize), padding(padding) {
+		SDL_RendererInfo info {};
+		if (ren != nullptr && SDL_GetRendererInfo(ren, &info) == 0) {
+			// 0 means the renderer has no limit
+			if (info.max_texture_width > 0)
+				pageWidth = std::min(pageWidth, info.max_texture_width);
+			if (info.max_texture_height > 0)
+				pageHeight = std::min(pageHeight, info.max_texture_height);
+		}
+	}
+
+	bool Atlas::place(Page &page, int w, int h, SDL_Point &pos) {
+		int bestY = std::numeric_limits<int>::max();
+		int bestWaste = std::numeric_limits<int>::max();
+		size_t bestNode = page.skyline.size();
+
+		// bottom-left: lowest top edge first, then the least wasted area under the rectangle
+		for (size_t i = 0; i < page.skyline.size(); ++i) {
+			const int x = page.skyline[i].x;
+			if (x + w > pageWidth)
+				break;
+
+			int y = 0;
+			int widthLeft = w;
+			size_t j = i;
+			while (widthLeft > 0 && j < page.skyline.size()) {
+				y = std::max(y, page.skyline[j].y);
+				widthLeft -= page.skyline[j].width;
+				++j;
+			}
+
+			if (y + h > pageHeight)
+				continue;
+
+			int waste = 0;
+			widthLeft = w;
+			for (size_t k = i; k < j; ++k) {
+				const int span = std::min(widthLeft, page.skyline[k].width);
+				waste += (y - page.skyline[k].y) * span;
+				widthLeft -= span;
+			}
+
+			if (y < bestY || (y == bestY && waste < bestWaste)) {
+				bestY = y;
+				bestWaste = waste;
+				bestNode = i;
+			}
+		}
+
+		if (bestNode == page.skyline.size())
+			return false;
+
+		pos = {page.skyline[bestNode].x, bestY};
+
+		// raise the skyline under the rectangle & trim the nodes it covers
+		page.skyline.insert(page.skyline.begin() + static_cast<std::ptrdiff_t>(bestNode), {pos.x, pos.y + h, w});
+		for (size_t i = bestNode + 1; i < page.skyline.size();) {
+			const int previousRight = page.skyline[i - 1].x + page.skyline[i - 1].width;
+			if (page.skyline[i].x >= previousRight)
+				break;
+
+			const int shrink = previousRight - page.skyline[i].x;
+			page.skyline[i].x += shrink;
+			page.skyline[i].width -= shrink;
+			if (page.skyline[i].width <= 0) {
+				page.skyline.erase(page.skyline.begin() + static_cast<std::ptrdiff_t>(i));
+			} else {
+				break;
+			}
+		}
+
+		// merge neighbours at the same height
+		for (size_t i = 0; i + 1 < page.skyline.size();) {
+			if (page.skyline[i].y == page.skyline[i + 1].y) {
+				page.skyline[i].width += page.skyline[i + 1].width;
+				page.skyline.erase(page.skyline.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+			} else {
+				++i;
+			}
+		}
+
+		page.usedWidth = std::max(page.usedWidth, pos.x + w);
+		page.usedHeight = std::max(page.usedHeight, pos.y + h);
+
+		return true;
+	}
+
+	int Atlas::insert(int w, int h) {
+		if (isBuilt) {
+			std::cout << "Atlas is already built\n";
+			return -1;
+		}
+
+		// pad the right & bottom so sampling never bleeds into a neighbour
+		const int paddedW = w + padding;
+		const int paddedH = h + padding;
+		if (w <= 0 || h <= 0 || paddedW > pageWidth || paddedH > pageHeight) {
+			std::cout << "Atlas region doesn't fit on a page: " << w << "x" << h << '\n';
+			return -1;
+		}
+
+		SDL_Point pos {};
+		int pageIndex = -1;
+		for (size_t i = 0; i < pages.size(); ++i) {
+			if (place(pages[i], paddedW, paddedH, pos)) {
+				pageIndex = static_cast<int>(i);
+				break;
+			}
+		}
+
+		// spill onto a new page
+		if (pageIndex == -1) {
+			Page newPage {};
+			newPage.skyline.push_back({0, 0, pageWidth});
+			pages.emplace_back(std::move(newPage));
+			pageIndex = static_cast<int>(pages.size()) - 1;
+			place(pages.back(), paddedW, paddedH, pos);
+		}
+
+		IMD newRegion = std::make_shared<ImageData>();
+		newRegion->clip = {pos.x, pos.y, w, h};
+		newRegion->imageWidth = w;
+		newRegion->imageHeight = h;
+		regions.emplace_back(newRegion);
+		regionPages.emplace_back(pageIndex);
+
+		return static_cast<int>(regions.size()) - 1;
+	}
+
+	bool Atlas::build(SDL_Renderer *ren) {
+		for (auto &page : pages) {
+			page.texture = std::make_shared<ImageData>();
+			page.texture->imageWidth = page.usedWidth;
+			page.texture->imageHeight = page.usedHeight;
+			page.texture->texture = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, page.usedWidth, page.usedHeight), MemoryTag::Image));
+			if (page.texture->texture == nullptr) {
+				std::cout << "Atlas page failed to be created: " << SDL_GetError() << '\n';
+				return false;
+			}
+			SDL_SetTextureBlendMode(page.texture->texture.get(), SDL_BLENDMODE_BLEND);
+
+			// clear the page so the padding stays transparent
+			std::vector<uint32_t> blank(static_cast<size_t>(page.usedWidth) * page.usedHeight, 0);
+			SDL_UpdateTexture(page.texture->texture.get(), nullptr, blank.data(), page.usedWidth * sizeof(uint32_t));
+		}
+
+		for (size_t i = 0; i < regions.size(); ++i)
+			regions[i]->texture = pages[regionPages[i]].texture->texture;
+
+		isBuilt = true;
+
+		return true;
+	}
+
+	bool Atlas::upload(int region, const void *pixels, int pitch) {
+		if (!isBuilt || region < 0 || region >= static_cast<int>(regions.size()))
+			return false;
+
+		const IMD &img = regions[region];
+		return SDL_UpdateTexture(img->texture.get(), &img->clip, pixels, pitch) == 0;
+	}
+
+	bool Atlas::upload(int region, SDL_Surface *surf) {
+		if (surf == nullptr)
+			return false;
+
+		if (surf->format->format == SDL_PIXELFORMAT_ARGB8888)
+			return upload(region, surf->pixels, surf->pitch);
+
+		SDL_Surface *converted = trackSurface(SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0), MemoryTag::Image);
+		if (converted == nullptr) {
+			std::cout << "Failed to convert atlas region: " << SDL_GetError() << '\n';
+			return false;
+		}
+
+		const bool uploaded = upload(region, converted->pixels, converted->pitch);
+		freeSurface(converted);
+
+		return uploaded;
+	}
+
+	IMD Atlas::getRegion(int region) const noexcept {
+		if (region < 0 || region >= static_cast<int>(regions.size()))
+			return nullptr;
+
+		return regions[region];
+	}
+
+	IMD Atlas::getPage(int page) const noexcept {
+		if (page < 0 || page >= static_cast<int>(pages.size()))
+			return nullptr;
+
+		return pages[page].texture;
+	}
+
+	int Atlas::getPageCount() const noexcept {
+		return static_cast<int>(pages.size());
+	}
+} // namespace Application::Helper
\ No newline at end of file
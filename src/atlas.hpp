@@ -0,0 +1,96 @@
+#pragma once
+
+#include <SDL.h>
+#include "data.hpp"
+#include <vector>
+
+/** Structure
+ *
+ * Atlas -> packs rectangles onto as few pages (textures) as possible with a skyline packer
+ * Region -> an ImageData that shares its page texture, drawn through ImageData::clip
+ *
+ *	-----------------------
+ *	| 0 | 1 | 2 | 3 |  7  |
+ *	|   |   |   |---|-----|      pages never exceed the renderer's max texture size,
+ *	|---|---|---| 5 |  8  |      a new page is started when nothing fits anymore
+ *	|  4    | 6 |   |     |
+ *	-----------------------
+ *
+ *  1. insert every rectangle (placement only)
+ *  2. build -> creates each page trimmed to what it uses
+ *  3. upload the pixels of every region
+ */
+
+namespace Application::Helper {
+	class Atlas final {
+	public:
+		/** Create an empty atlas.
+		 *
+		 * \param ren -> the renderer the pages are created for (limits the page size)
+		 * \param pageSize -> the preferred page width & height
+		 * \param padding -> the space kept between regions
+		 */
+		explicit Atlas(SDL_Renderer *ren, int pageSize = 1024, int padding = 1);
+		/** Reserve space for a rectangle.
+		 *
+		 * \param w -> width of the rectangle
+		 * \param h -> height of the rectangle
+		 * \return the index of the region or -1 if it is larger than a page.
+		 */
+		int insert(int w, int h);
+		/** Create the page textures, nothing can be inserted afterwards.
+		 *
+		 * \param ren -> the renderer to use
+		 * \return true if every page was created, otherwise false.
+		 */
+		bool build(SDL_Renderer *ren);
+		/** Copy ARGB8888 pixels into a region.
+		 *
+		 * \param region -> the index returned by insert
+		 * \param pixels -> the pixels (region sized)
+		 * \param pitch -> the length of a row in bytes
+		 * \return true if the pixels were uploaded, otherwise false.
+		 */
+		bool upload(int region, const void *pixels, int pitch);
+		/** Copy a surface into a region (converted to ARGB8888 if needed).
+		 */
+		bool upload(int region, SDL_Surface *surf);
+		/** Gets a region handle, the texture is set once the atlas is built.
+		 *
+		 * \param region -> the index returned by insert
+		 * \return the region or nullptr if the index is invalid.
+		 */
+		IMD getRegion(int region) const noexcept;
+		/** Gets the texture of a page.
+		 *
+		 * \return the page (whole texture, no clip) or nullptr if it doesn't exist.
+		 */
+		IMD getPage(int page) const noexcept;
+		int getPageCount() const noexcept;
+
+	private:
+		struct SkylineNode final {
+			int x {0};
+			int y {0};
+			int width {0};
+		};
+
+		struct Page final {
+			std::vector<SkylineNode> skyline {};
+			int usedWidth {0};
+			int usedHeight {0};
+			IMD texture {nullptr};
+		};
+
+		bool place(Page &page, int w, int h, SDL_Point &pos);
+
+	private:
+		int pageWidth {1024};
+		int pageHeight {1024};
+		int padding {1};
+		bool isBuilt {false};
+		std::vector<Page> pages {};
+		std::vector<IMD> regions {};
+		std::vector<int> regionPages {};
+	};
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "backend.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace Application::Helper {
+	RendererOptions parseRendererOptions(int argc, char **argv) {
+		return parseLaunchOptions(argc, argv).renderer;
+	}
+
+	LaunchOptions parseLaunchOptions(int argc, char **argv) {
+		LaunchOptions options {};
+
+		if (const char *driver = SDL_GetHint(SDL_HINT_RENDER_DRIVER))
+			options.renderer.driver = driver;
+		if (const char *vsync = SDL_GetHint(SDL_HINT_RENDER_VSYNC))
+			options.renderer.vsync = std::string_view(vsync) != "0";
+
+		for (int i = 1; i < argc; ++i) {
+			const std::string_view arg = argv[i];
+			if (arg.starts_with("--renderer=")) {
+				options.renderer.driver = arg.substr(11);
+			} else if (arg.starts_with("--vsync=")) {
+				options.renderer.vsync = arg.substr(8) != "off" && arg.substr(8) != "0";
+			} else if (arg.starts_with("--record=")) {
+				options.recordPath = arg.substr(9);
+			} else if (arg.starts_with("--replay=")) {
+				options.replayPath = arg.substr(9);
+			} else if (arg == "--unpaced") {
+				options.unpaced = true;
+			} else if (arg.starts_with("--clock=")) {
+				options.clock = arg.substr(8);
+			} else if (arg.starts_with("--clock-start=")) {
+				options.clockStart = std::strtoll(argv[i] + 14, nullptr, 10);
+			} else if (arg.starts_with("--clock-step=")) {
+				options.clockStep = std::max<int64_t>(1, std::strtoll(argv[i] + 13, nullptr, 10));
+			} else {
+				std::cout << "Unknown option: " << arg << '\n';
+			}
+		}
+
+		if (options.renderer.driver == "auto")
+			options.renderer.driver.clear();
+
+		if (options.clock != "wall" && options.clock != "fixed") {
+			std::cout << "Unknown clock: " << options.clock << ", using the wall clock\n";
+			options.clock = "wall";
+		}
+
+		return options;
+	}
+
+	// try a single driver, with vsync first if it can do it
+	static Utilities::PTR<SDL_Renderer> tryDriver(SDL_Window *window, int index, const SDL_RendererInfo &info, bool vsync) {
+		const uint32_t baseFlags = (info.flags & SDL_RENDERER_ACCELERATED) ? SDL_RENDERER_ACCELERATED : SDL_RENDERER_SOFTWARE;
+
+		if (vsync && (info.flags & SDL_RENDERER_PRESENTVSYNC)) {
+			if (auto ren = Utilities::PTR<SDL_Renderer>(SDL_CreateRenderer(window, index, baseFlags | SDL_RENDERER_PRESENTVSYNC)))
+				return ren;
+		}
+
+		return Utilities::PTR<SDL_Renderer>(SDL_CreateRenderer(window, index, baseFlags));
+	}
+
+	Utilities::PTR<SDL_Renderer> createRenderer(SDL_Window *window, const RendererOptions &options, bool &isVSync) {
+		isVSync = false;
+
+		struct Candidate final {
+			int index {-1};
+			SDL_RendererInfo info {};
+		};
+
+		std::vector<Candidate> candidates {};
+		for (int i = 0; i < SDL_GetNumRenderDrivers(); ++i) {
+			Candidate candidate {i};
+			if (SDL_GetRenderDriverInfo(i, &candidate.info) == 0)
+				candidates.emplace_back(candidate);
+		}
+
+		// the requested driver goes first, then accelerated drivers, software last (SDL's order is kept otherwise)
+		const auto rank = [&](const Candidate &candidate) {
+			if (!options.driver.empty() && options.driver == candidate.info.name)
+				return 0;
+			if (options.driver == "software")
+				return (candidate.info.flags & SDL_RENDERER_SOFTWARE) ? 0 : 2;
+			return (candidate.info.flags & SDL_RENDERER_ACCELERATED) ? 1 : 2;
+		};
+		std::stable_sort(candidates.begin(), candidates.end(), [&](const Candidate &a, const Candidate &b) {return rank(a) < rank(b);});
+
+		if (!options.driver.empty() && options.driver != "software" && (candidates.empty() || rank(candidates.front()) != 0))
+			std::cout << "Render driver not found: " << options.driver << ", probing instead\n";
+
+		for (const auto &candidate : candidates) {
+			auto ren = tryDriver(window, candidate.index, candidate.info, options.vsync);
+			if (ren == nullptr) {
+				std::cout << "Render driver failed (" << candidate.info.name << "): " << SDL_GetError() << '\n';
+				continue;
+			}
+
+			SDL_RendererInfo info {};
+			if (SDL_GetRendererInfo(ren.get(), &info) == 0) {
+				isVSync = (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+				std::cout << "Renderer: " << info.name << (isVSync ? " (vsync)" : "") << '\n';
+			}
+
+			return ren;
+		}
+
+		// no driver list (or every driver failed), let SDL decide
+		auto ren = Utilities::PTR<SDL_Renderer>(SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE));
+		if (ren == nullptr)
+			std::cout << "Failed to create a renderer: " << SDL_GetError() << '\n';
+
+		return ren;
+	}
+} // namespace Application::Helper
\ No newline at end of file
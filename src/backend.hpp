@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SDL.h>
+#include "util.hpp"
+#include <string>
+
+/** Structure
+ *
+ * RendererOptions -> which backend to use, read from the command line (SDL's render hints are the fallback)
+ * LaunchOptions -> the renderer options & how the session is driven (see recorder.hpp for the traces)
+ *
+ *	--renderer=<auto|software|name of an SDL render driver>
+ *	--vsync=<on|off>
+ *	--record=<file>    write every event the app handles to a trace
+ *	--replay=<file>    feed a trace back in, on the same loop iterations it was recorded on
+ *	--unpaced          never wait & draw every iteration (benchmarks)
+ *	--clock=<wall|fixed>           where the shown time comes from (see clock.hpp), fixed runs unpaced
+ *	--clock-start=<unix seconds>   the first time of the fixed clock (now by default)
+ *	--clock-step=<ms>              how far the fixed clock moves every iteration
+ *
+ *  auto probes every driver through SDL_GetRenderDriverInfo, accelerated ones first,
+ *  the software renderer is the last resort so it still runs headless (SDL_VIDEODRIVER=dummy)
+ */
+
+namespace Application::Helper {
+	struct RendererOptions final {
+		// empty or "auto" probes the drivers
+		std::basic_string<char> driver {};
+		bool vsync {true};
+	};
+
+	struct LaunchOptions final {
+		RendererOptions renderer {};
+		// empty when the session isn't recorded / replayed
+		std::basic_string<char> recordPath {};
+		std::basic_string<char> replayPath {};
+		bool unpaced {false};
+		// "fixed" steps the clock by clockStep every iteration, starting at clockStart (-1 for now)
+		std::basic_string<char> clock {"wall"};
+		int64_t clockStart {-1};
+		int64_t clockStep {16};
+	};
+
+	/** Read the renderer options.
+	 *
+	 * \param argc -> the argument count of main
+	 * \param argv -> the arguments of main
+	 * \return the options, SDL_RENDER_DRIVER & SDL_RENDER_VSYNC are used for what isn't on the command line.
+	 */
+	RendererOptions parseRendererOptions(int argc, char **argv);
+	/** Read every option of the app.
+	 *
+	 * \param argc -> the argument count of main
+	 * \param argv -> the arguments of main
+	 * \return the options, unknown ones are reported & ignored.
+	 */
+	LaunchOptions parseLaunchOptions(int argc, char **argv);
+	/** Create a renderer, falling back to the next usable driver when one fails.
+	 *
+	 * \param window -> the window to render to
+	 * \param options -> the preferred driver & vsync
+	 * \param isVSync -> set to whether presenting waits for the display
+	 * \return the renderer or nullptr if no driver could be used.
+	 */
+	Utilities::PTR<SDL_Renderer> createRenderer(SDL_Window *window, const RendererOptions &options, bool &isVSync);
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "bundle.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace Application::Helper {
+	static std::string_view nameOf(const BundleEntry &entry) noexcept {
+		return {entry.name.data(), strnlen(entry.name.data(), entry.name.size())};
+	}
+
+	bool Bundle::open(std::string_view filePath) {
+		header = nullptr;
+		entries = nullptr;
+
+		if (!file.open(filePath))
+			return false;
+
+		const auto failed = [&](const char *reason) {
+			std::cout << "Failed to open bundle: " << reason << '\n';
+			file.close();
+			return false;
+		};
+
+		if (file.size() < sizeof(BundleHeader))
+			return failed("file is too small");
+
+		const auto *newHeader = reinterpret_cast<const BundleHeader *>(file.data());
+		if (newHeader->magic != BundleHeader {}.magic)
+			return failed("not a bundle");
+
+		if (newHeader->version != version)
+			return failed("unsupported version");
+
+		if (file.size() < sizeof(BundleHeader) + static_cast<size_t>(newHeader->count) * sizeof(BundleEntry))
+			return failed("index is truncated");
+
+		const auto *newEntries = reinterpret_cast<const BundleEntry *>(file.data() + sizeof(BundleHeader));
+		for (uint32_t i = 0; i < newHeader->count; ++i) {
+			const auto &entry = newEntries[i];
+			if (entry.offset % alignment != 0 || entry.offset + entry.size > file.size() ||
+				static_cast<uint64_t>(entry.pitch) * entry.height > entry.size)
+				return failed("entry is out of bounds");
+		}
+
+		header = newHeader;
+		entries = newEntries;
+
+		return true;
+	}
+
+	void Bundle::close() noexcept {
+		header = nullptr;
+		entries = nullptr;
+		file.close();
+	}
+
+	const BundleEntry *Bundle::find(std::string_view name) const noexcept {
+		if (header == nullptr)
+			return nullptr;
+
+		const BundleEntry *end = entries + header->count;
+		const BundleEntry *iter = std::lower_bound(entries, end, name, [](const BundleEntry &entry, std::string_view value) {
+			return nameOf(entry) < value;
+		});
+
+		if (iter == end || nameOf(*iter) != name)
+			return nullptr;
+
+		return iter;
+	}
+
+	std::vector<const BundleEntry *> Bundle::findAll(std::string_view prefix) const {
+		std::vector<const BundleEntry *> found {};
+		if (header == nullptr)
+			return found;
+
+		const BundleEntry *end = entries + header->count;
+		const BundleEntry *iter = std::lower_bound(entries, end, prefix, [](const BundleEntry &entry, std::string_view value) {
+			return nameOf(entry) < value;
+		});
+
+		for (; iter != end && nameOf(*iter).starts_with(prefix); ++iter)
+			found.emplace_back(iter);
+
+		return found;
+	}
+
+	const void *Bundle::getPixels(const BundleEntry &entry) const noexcept {
+		return file.data() + entry.offset;
+	}
+
+	uint32_t Bundle::getFormat() const noexcept {
+		return header != nullptr ? header->format : SDL_PIXELFORMAT_UNKNOWN;
+	}
+
+	bool Bundle::isOpen() const noexcept {
+		return header != nullptr;
+	}
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SDL.h>
+#include "file.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** Structure
+ *
+ * Bundle -> a prebaked file of already decoded images (built by tools/packer.cpp), read through a mapping
+ *
+ *	---------------------------------------------------------------
+ *	| BundleHeader | BundleEntry 0..n (sorted by name) | pixels ... |
+ *	---------------------------------------------------------------
+ *  pixels are stored in the header's SDL pixel format, rows tightly packed (pitch = width * 4)
+ *  and each entry starts on a 16 byte boundary so it can be handed to SDL_UpdateTexture as is.
+ */
+
+namespace Application::Helper {
+	struct BundleHeader final {
+		std::array<char, 4> magic {'T', 'B', 'N', 'D'};
+		uint32_t version {2};
+		uint32_t count {0};
+		// SDL_PixelFormatEnum of every entry
+		uint32_t format {SDL_PIXELFORMAT_ARGB8888};
+	};
+
+	struct BundleEntry final {
+		// path relative to the bundled directory with '/' separators, e.g. "gif-extract/0.png"
+		std::array<char, 64> name {};
+		uint64_t offset {0};
+		uint32_t size {0};
+		uint32_t width {0};
+		uint32_t height {0};
+		uint32_t pitch {0};
+		// size of the file the pixels were decoded from, a bundle that doesn't match its directory is stale
+		uint64_t sourceSize {0};
+	};
+
+	static_assert(sizeof(BundleHeader) == 16, "bundle header layout changed");
+	static_assert(sizeof(BundleEntry) == 96, "bundle entry layout changed");
+
+	class Bundle final {
+	public:
+		static constexpr uint32_t version {2};
+		static constexpr size_t alignment {16};
+
+		/** Map a bundle & validate its index.
+		 *
+		 * \param filePath -> the location of the bundle
+		 * \return true if the bundle can be read from, otherwise false.
+		 */
+		bool open(std::string_view filePath);
+		/** Unmap the bundle, every entry & pixel pointer handed out becomes invalid.
+		 */
+		void close() noexcept;
+		/** Find an entry by name (binary search, no allocation).
+		 *
+		 * \param name -> the path relative to the bundled directory
+		 * \return the entry or nullptr if it isn't bundled.
+		 */
+		const BundleEntry *find(std::string_view name) const noexcept;
+		/** Find every entry within a directory of the bundle, sorted by name.
+		 *
+		 * \param prefix -> the directory relative to the bundled directory, e.g. "gif-extract/"
+		 * \return the entries (empty if none were found).
+		 */
+		std::vector<const BundleEntry *> findAll(std::string_view prefix) const;
+		/** Gets the pixels of an entry, they point straight into the mapping.
+		 */
+		const void *getPixels(const BundleEntry &entry) const noexcept;
+		uint32_t getFormat() const noexcept;
+		bool isOpen() const noexcept;
+
+	private:
+		MappedFile file {};
+		const BundleHeader *header {nullptr};
+		const BundleEntry *entries {nullptr};
+	};
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "clock.hpp"
+#include <SDL.h>
+#include <algorithm>
+
+namespace Application::Helper {
+	Clock::Clock() : last(std::chrono::steady_clock::now()) {}
+
+	Clock::Clock(TimePoint start, std::chrono::milliseconds step) : mode(ClockMode::FixedStep), current(start), step(step) {}
+
+	Clock::Clock(std::vector<TimePoint> script) : mode(ClockMode::Scripted), script(std::move(script)) {
+		SDL_assert(!this->script.empty());
+
+		current = this->script.front();
+		next = 1;
+	}
+
+	double Clock::tick() {
+		switch (mode) {
+			case ClockMode::Wall: {
+				const auto now = std::chrono::steady_clock::now();
+				const auto elapsed = std::chrono::duration<double, std::milli>(now - last).count();
+				last = now;
+				return elapsed;
+			}
+
+			case ClockMode::FixedStep: {
+				current += step;
+				return std::chrono::duration<double, std::milli>(step).count();
+			}
+
+			case ClockMode::Scripted: {
+				if (next >= script.size())
+					return 0.0;
+
+				const auto previous = current;
+				current = script[next++];
+				return std::max(0.0, std::chrono::duration<double, std::milli>(current - previous).count());
+			}
+		}
+
+		return 0.0;
+	}
+
+	Clock::TimePoint Clock::now() const {
+		return mode == ClockMode::Wall ? std::chrono::system_clock::now() : current;
+	}
+
+	ClockMode Clock::getMode() const noexcept {
+		return mode;
+	}
+
+	bool Clock::isRealTime() const noexcept {
+		return mode == ClockMode::Wall;
+	}
+
+	bool Clock::isFinished() const noexcept {
+		return mode == ClockMode::Scripted && next >= script.size();
+	}
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/** Structure
+ *
+ * Clock -> where the app gets the time it shows & the time between loop iterations
+ *
+ *	Wall       now() is the system clock, tick() measures the steady clock (the only real time mode)
+ *	FixedStep  every tick() moves now() forward by the same step, from any start
+ *	Scripted   every tick() jumps to the next time of a list (minute rollovers, DST edges), the last one is held
+ *
+ *  only the wall clock may be waited on, the others are meant to be stepped as fast as the loop can run
+ */
+
+namespace Application::Helper {
+	enum class ClockMode : uint8_t {
+		Wall,
+		FixedStep,
+		Scripted
+	};
+
+	class Clock final {
+	public:
+		using TimePoint = std::chrono::system_clock::time_point;
+
+		// the wall clock
+		Clock();
+		/** Create a fixed step clock.
+		 *
+		 * \param start -> the time shown until the first tick
+		 * \param step -> how far every tick moves the clock
+		 */
+		Clock(TimePoint start, std::chrono::milliseconds step);
+		/** Create a scripted clock.
+		 *
+		 * \param script -> the time of each tick, the first one is shown until the first tick (can't be empty)
+		 */
+		explicit Clock(std::vector<TimePoint> script);
+
+		/** Move to the next loop iteration.
+		 *
+		 * \return the time since the previous tick (ms), never negative (a script going back in time is 0).
+		 */
+		double tick();
+		// the time the app shows
+		TimePoint now() const;
+		ClockMode getMode() const noexcept;
+		bool isRealTime() const noexcept;
+		// the script has no times left (always false for the other modes)
+		bool isFinished() const noexcept;
+
+	private:
+		ClockMode mode {ClockMode::Wall};
+		TimePoint current {};
+		std::chrono::milliseconds step {0};
+		std::vector<TimePoint> script {};
+		size_t next {0};
+		// wall clock deltas come from the steady clock, the system clock can be changed by the user
+		std::chrono::steady_clock::time_point last {};
+	};
+} // namespace Application::Helper
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <SDL.h>
 #include <string>
+#include <string_view>
 #include <memory>
 
 namespace Application::Helper {
@@ -13,8 +14,9 @@ namespace Application::Helper {
 
 	struct MessageData final {
 		MessageData &operator=(MessageData &) {return *this;}
-		std::basic_string<char> msg {};
-		std::basic_string<char> fontFile {};
+		// views, the callers own the strings for the duration of the call (shaping copies what it keeps)
+		std::string_view msg {};
+		std::string_view fontFile {};
 		ColorData col {};
 		int fontSize {0};
 		int outlineThickness {1};
@@ -25,6 +27,8 @@ namespace Application::Helper {
 		std::shared_ptr<SDL_Texture> texture {nullptr};
 		int imageWidth {0};
 		int imageHeight {0};
+		// the part of the texture this image covers (atlas regions), empty for the whole texture
+		SDL_Rect clip {0, 0, 0, 0};
 	};
 	// handle
 	using IMD = std::shared_ptr<ImageData>;
@@ -0,0 +1,131 @@
+#include "file.hpp"
+#include <iostream>
+#include <utility>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Application::Helper {
+	MappedFile::MappedFile(MappedFile &&other) noexcept {
+		*this = std::move(other);
+	}
+
+	MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+		if (this != &other) {
+			close();
+			bytes = std::exchange(other.bytes, nullptr);
+			length = std::exchange(other.length, 0);
+#ifdef _WIN32
+			fileHandle = std::exchange(other.fileHandle, nullptr);
+			mapHandle = std::exchange(other.mapHandle, nullptr);
+#endif
+		}
+
+		return *this;
+	}
+
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+	bool MappedFile::open(std::string_view filePath) {
+		close();
+		const std::basic_string<char> path {filePath};
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			std::cout << "Failed to open file: " << path << '\n';
+			return false;
+		}
+
+		LARGE_INTEGER fileSize {};
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+			CloseHandle(file);
+			std::cout << "Failed to map empty file: " << path << '\n';
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			CloseHandle(file);
+			std::cout << "Failed to map file: " << path << '\n';
+			return false;
+		}
+
+		void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			std::cout << "Failed to map file: " << path << '\n';
+			return false;
+		}
+
+		fileHandle = file;
+		mapHandle = mapping;
+		bytes = static_cast<const std::byte *>(view);
+		length = static_cast<size_t>(fileSize.QuadPart);
+#else
+		const int file = ::open(path.c_str(), O_RDONLY);
+		if (file == -1) {
+			std::cout << "Failed to open file: " << path << '\n';
+			return false;
+		}
+
+		struct stat fileStat {};
+		if (fstat(file, &fileStat) == -1 || fileStat.st_size == 0) {
+			::close(file);
+			std::cout << "Failed to map empty file: " << path << '\n';
+			return false;
+		}
+
+		void *view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		// the mapping keeps its own reference to the file
+		::close(file);
+		if (view == MAP_FAILED) {
+			std::cout << "Failed to map file: " << path << '\n';
+			return false;
+		}
+
+		bytes = static_cast<const std::byte *>(view);
+		length = static_cast<size_t>(fileStat.st_size);
+#endif
+
+		return true;
+	}
+
+	void MappedFile::close() noexcept {
+		if (bytes == nullptr)
+			return;
+
+#ifdef _WIN32
+		UnmapViewOfFile(bytes);
+		CloseHandle(mapHandle);
+		CloseHandle(fileHandle);
+		mapHandle = nullptr;
+		fileHandle = nullptr;
+#else
+		munmap(const_cast<std::byte *>(bytes), length);
+#endif
+		bytes = nullptr;
+		length = 0;
+	}
+
+	const std::byte *MappedFile::data() const noexcept {
+		return bytes;
+	}
+
+	size_t MappedFile::size() const noexcept {
+		return length;
+	}
+
+	bool MappedFile::isOpen() const noexcept {
+		return bytes != nullptr;
+	}
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/** Structure
+ *
+ * MappedFile -> a read-only view of a whole file, mapped into memory once and shared by its users
+ */
+
+namespace Application::Helper {
+	class MappedFile final {
+	public:
+		MappedFile() = default;
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator=(const MappedFile &) = delete;
+		MappedFile(MappedFile &&other) noexcept;
+		MappedFile &operator=(MappedFile &&other) noexcept;
+		~MappedFile();
+
+		/** Map a file into memory (read-only).
+		 *
+		 * \param filePath -> the location of the file
+		 * \return true if the file was mapped, otherwise false.
+		 */
+		bool open(std::string_view filePath);
+		/** Unmap the file, any pointer into it becomes invalid.
+		 */
+		void close() noexcept;
+		const std::byte *data() const noexcept;
+		size_t size() const noexcept;
+		bool isOpen() const noexcept;
+
+	private:
+		const std::byte *bytes {nullptr};
+		size_t length {0};
+#ifdef _WIN32
+		void *fileHandle {nullptr};
+		void *mapHandle {nullptr};
+#endif
+	};
+} // namespace Application::Helper
\ No newline at end of file
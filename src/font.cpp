@@ -0,0 +1,81 @@
+#include "font.hpp"
+#include "memstats.hpp"
+#include <iostream>
+
+namespace Application::Helper {
+	FontCache::~FontCache() {
+		for (auto *font : fonts)
+			TTF_CloseFont(font);
+	}
+
+	const MappedFile *FontCache::map(const std::basic_string<char> &fontFile) {
+		auto iter = files.find(fontFile);
+		if (iter != files.end())
+			return iter->second.get();
+
+		auto file = std::make_unique<MappedFile>();
+		if (!file->open(fontFile))
+			return nullptr;
+
+		return files.insert({fontFile, std::move(file)}).first->second.get();
+	}
+
+	bool FontCache::load(std::string_view fontFile) {
+		MemoryScope scope {MemoryTag::Font};
+
+		const std::basic_string<char> path {fontFile};
+		const bool wasMapped = files.contains(path);
+
+		const MappedFile *file = map(path);
+		if (file == nullptr)
+			return false;
+
+		// make sure the bytes are actually a font before anyone switches to it
+		TTF_Font *font = TTF_OpenFontRW(SDL_RWFromConstMem(file->data(), static_cast<int>(file->size())), 1, 12);
+		if (font == nullptr) {
+			std::cout << "TTF_OpenFontRW error: " << TTF_GetError() << '\n';
+			if (!wasMapped)
+				files.erase(path);
+			return false;
+		}
+		TTF_CloseFont(font);
+
+		return true;
+	}
+
+	TTF_Font *FontCache::getFont(const FontKey &key, uint32_t *id) {
+		MemoryScope scope {MemoryTag::Font};
+
+		auto iter = fontIds.find(key);
+		if (iter != fontIds.end()) {
+			if (id != nullptr)
+				*id = iter->second;
+			return fonts[iter->second];
+		}
+
+		const MappedFile *file = map(key.fontFile);
+		if (file == nullptr)
+			return nullptr;
+
+		// the RWops is closed with the font, the mapped bytes stay with the cache
+		TTF_Font *font = TTF_OpenFontRW(SDL_RWFromConstMem(file->data(), static_cast<int>(file->size())), 1, key.fontSize);
+		if (font == nullptr) {
+			std::cout << "TTF_OpenFontRW error: " << TTF_GetError() << '\n';
+			return nullptr;
+		}
+		TTF_SetFontOutline(font, key.outlineThickness);
+
+		const auto newId = static_cast<uint32_t>(fonts.size());
+		fontIds.insert({key, newId});
+		fonts.emplace_back(font);
+
+		if (id != nullptr)
+			*id = newId;
+
+		return font;
+	}
+
+	void FontCache::printFontCount() const noexcept {
+		std::cout << "Mapped Fonts: " << files.size() << ", Font Handles: " << fonts.size() << '\n';
+	}
+} // namespace Application::Helper
\ No newline at end of file
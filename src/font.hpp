@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include "file.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** Structure
+ *
+ * FontKey -> identifies a font handle (file, point size, outline thickness)
+ * FontCache -> maps each font file into memory once and opens every handle from those bytes
+ *
+ *	Onest.ttf (mapped once) ---> (16, 0) (28, 0) (28, 1) (96, 0) ...
+ */
+
+namespace Application::Helper {
+	struct FontKey final {
+		bool operator==(const FontKey &) const = default;
+		std::basic_string<char> fontFile {};
+		int fontSize {0};
+		int outlineThickness {0};
+	};
+
+	struct FontKeyHash final {
+		size_t operator()(const FontKey &key) const noexcept {
+			size_t seed = std::hash<std::basic_string<char>> {}(key.fontFile);
+			seed ^= std::hash<int> {}(key.fontSize) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			seed ^= std::hash<int> {}(key.outlineThickness) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
+		}
+	};
+
+	class FontCache final {
+	public:
+		FontCache() = default;
+		FontCache(const FontCache &) = delete;
+		FontCache &operator=(const FontCache &) = delete;
+		~FontCache();
+
+		/** Map a font file into memory without opening a handle, used to check a font before switching to it.
+		 *
+		 * \param fontFile -> the location of the font file
+		 * \return true if the file is mapped and can be opened as a font, otherwise false.
+		 */
+		bool load(std::string_view fontFile);
+		/** Gets a cached font handle, opening it from the mapped file on first use.
+		 *
+		 * \param key -> the font file, point size & outline thickness
+		 * \param id -> (optional) receives a stable id of the handle
+		 * \return the font handle (owned by the cache) or nullptr if the operation failed.
+		 */
+		TTF_Font *getFont(const FontKey &key, uint32_t *id = nullptr);
+		/** Prints the number of mapped files & open handles.
+		 */
+		void printFontCount() const noexcept;
+
+	private:
+		const MappedFile *map(const std::basic_string<char> &fontFile);
+
+	private:
+		// declared first so the bytes outlive the handles opened from them
+		std::unordered_map<std::basic_string<char>, std::unique_ptr<MappedFile>> files {};
+		std::unordered_map<FontKey, uint32_t, FontKeyHash> fontIds {};
+		std::vector<TTF_Font *> fonts {};
+	};
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,436 @@
+#include "gif.hpp"
+#include "memstats.hpp"
+#include "profiler.hpp"
+#include "resample.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace Application::Helper {
+	// browsers treat tiny delays as "as fast as possible" and slow them down, do the same
+	static constexpr int minimumDelay {20};
+	static constexpr int fallbackDelay {100};
+
+	static uint32_t toARGB(uint8_t r, uint8_t g, uint8_t b) noexcept {
+		return 0xFF000000u | (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+	}
+
+	bool GifStream::hasBytes(size_t count) const noexcept {
+		return pos + count <= file.size();
+	}
+
+	uint8_t GifStream::readByte() noexcept {
+		if (!hasBytes(1))
+			return 0;
+
+		return static_cast<uint8_t>(file.data()[pos++]);
+	}
+
+	uint16_t GifStream::readWord() noexcept {
+		const uint16_t low = readByte();
+		const uint16_t high = readByte();
+
+		return static_cast<uint16_t>(low | (high << 8));
+	}
+
+	bool GifStream::open(std::string_view filePath, int fitWidth, int fitHeight) {
+		if (!file.open(filePath))
+			return false;
+
+		this->fitWidth = fitWidth;
+		this->fitHeight = fitHeight;
+
+		if (!readHeader()) {
+			std::cout << "Failed to read gif: " << filePath << '\n';
+			file.close();
+			return false;
+		}
+
+		if (next() == nullptr) {
+			std::cout << "Gif has no frames: " << filePath << '\n';
+			file.close();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool GifStream::readHeader() {
+		if (!hasBytes(13))
+			return false;
+
+		const auto *signature = reinterpret_cast<const char *>(file.data());
+		if (std::string_view(signature, 6) != "GIF87a" && std::string_view(signature, 6) != "GIF89a")
+			return false;
+		pos = 6;
+
+		width = readWord();
+		height = readWord();
+		const uint8_t packed = readByte();
+		readByte(); // background colour index, disposal restores to transparent like browsers do
+		readByte(); // pixel aspect ratio
+
+		if (width == 0 || height == 0)
+			return false;
+
+		if (static_cast<int64_t>(width) * height > maxPixels) {
+			std::cout << "Gif is too large (" << width << "x" << height << ")\n";
+			return false;
+		}
+
+		hasGlobalPalette = (packed & 0x80) != 0;
+		if (hasGlobalPalette) {
+			const int count = 1 << ((packed & 0x07) + 1);
+			if (!hasBytes(count * 3))
+				return false;
+
+			for (int i = 0; i < count; ++i) {
+				const uint8_t r = readByte();
+				const uint8_t g = readByte();
+				const uint8_t b = readByte();
+				globalPalette[i] = toARGB(r, g, b);
+			}
+		}
+
+		firstFrame = pos;
+		canvas.assign(static_cast<size_t>(width) * height, 0);
+		indices.reserve(canvas.size());
+
+		// only a gif that covers the size is scaled down, a smaller one is stretched by the renderer
+		if (fitWidth > 0 && fitHeight > 0 && std::max(static_cast<double>(fitWidth) / width, static_cast<double>(fitHeight) / height) < 1.0) {
+			fitted.assign(static_cast<size_t>(fitWidth) * fitHeight, 0);
+		} else {
+			fitWidth = 0;
+			fitHeight = 0;
+		}
+
+		return true;
+	}
+
+	bool GifStream::skipSubBlocks() {
+		while (hasBytes(1)) {
+			const uint8_t size = readByte();
+			if (size == 0)
+				return true;
+
+			if (!hasBytes(size))
+				return false;
+			pos += size;
+		}
+
+		return false;
+	}
+
+	const GifFrame *GifStream::next() {
+		if (!file.isOpen())
+			return nullptr;
+
+		Disposal disposal = Disposal::None;
+		int transparent = -1;
+		int delay = fallbackDelay;
+		bool hasLooped = false;
+
+		while (true) {
+			if (!hasBytes(1)) {
+				std::cout << "Gif ended without a trailer\n";
+				return nullptr;
+			}
+
+			switch (readByte()) {
+				// extension
+				case 0x21: {
+					const uint8_t label = readByte();
+					if (label == 0xF9 && hasBytes(6) && static_cast<uint8_t>(file.data()[pos]) == 4) {
+						// graphic control extension
+						readByte();
+						const uint8_t packed = readByte();
+						const uint16_t centiseconds = readWord();
+						const uint8_t index = readByte();
+
+						disposal = static_cast<Disposal>(std::min((packed >> 2) & 0x07, 3));
+						transparent = (packed & 0x01) ? index : -1;
+						delay = centiseconds * 10 < minimumDelay ? fallbackDelay : centiseconds * 10;
+					}
+
+					if (!skipSubBlocks())
+						return nullptr;
+				} break;
+
+				// image descriptor
+				case 0x2C: {
+					if (!decodeImage(disposal, transparent, delay))
+						return nullptr;
+
+					return &frame;
+				}
+
+				// trailer, start over from the first frame
+				case 0x3B: {
+					if (hasLooped || !hasDecodedFrame)
+						return nullptr;
+
+					hasLooped = true;
+					pos = firstFrame;
+					std::fill(canvas.begin(), canvas.end(), 0);
+					lastDisposal = Disposal::None;
+				} break;
+
+				default: {
+					std::cout << "Unknown gif block\n";
+					return nullptr;
+				}
+			}
+		}
+	}
+
+	void GifStream::disposePrevious() {
+		switch (lastDisposal) {
+			case Disposal::Background: {
+				for (int y = lastY; y < lastY + lastH; ++y)
+					std::fill_n(canvas.begin() + static_cast<size_t>(y) * width + lastX, lastW, 0);
+			} break;
+
+			case Disposal::Previous: {
+				canvas = previousCanvas;
+			} break;
+
+			default:
+				break;
+		}
+	}
+
+	bool GifStream::decodeImage(Disposal disposal, int transparent, int delay) {
+		if (!hasBytes(9))
+			return false;
+
+		const int frameX = readWord();
+		const int frameY = readWord();
+		const int frameW = readWord();
+		const int frameH = readWord();
+		const uint8_t packed = readByte();
+		const bool isInterlaced = (packed & 0x40) != 0;
+
+		// everything below writes inside the canvas, a frame hanging off the screen would have to be clipped row by row
+		if (frameX + frameW > width || frameY + frameH > height) {
+			std::cout << "Gif frame is outside the screen (" << frameW << "x" << frameH << " at " << frameX << "," << frameY << ")\n";
+			return false;
+		}
+
+		const std::array<uint32_t, 256> *palette = &globalPalette;
+		if (packed & 0x80) {
+			const int count = 1 << ((packed & 0x07) + 1);
+			if (!hasBytes(count * 3))
+				return false;
+
+			for (int i = 0; i < count; ++i) {
+				const uint8_t r = readByte();
+				const uint8_t g = readByte();
+				const uint8_t b = readByte();
+				localPalette[i] = toARGB(r, g, b);
+			}
+			palette = &localPalette;
+		} else if (!hasGlobalPalette) {
+			std::cout << "Gif frame has no palette\n";
+			return false;
+		}
+
+		const int minCodeSize = readByte();
+		indices.assign(static_cast<size_t>(frameW) * frameH, 0);
+		if (!decodeLZW(minCodeSize, indices))
+			return false;
+
+		disposePrevious();
+		if (disposal == Disposal::Previous)
+			previousCanvas = canvas;
+
+		for (int row = 0; row < frameH; ++row) {
+			// interlaced rows are stored in four passes: every 8th, every 8th + 4, every 4th + 2, every 2nd + 1
+			int y = row;
+			if (isInterlaced) {
+				const int pass1 = (frameH + 7) / 8;
+				const int pass2 = pass1 + (frameH + 3) / 8;
+				const int pass3 = pass2 + (frameH + 1) / 4;
+				if (row < pass1)
+					y = row * 8;
+				else if (row < pass2)
+					y = (row - pass1) * 8 + 4;
+				else if (row < pass3)
+					y = (row - pass2) * 4 + 2;
+				else
+					y = (row - pass3) * 2 + 1;
+			}
+
+			if (y >= frameH)
+				continue;
+
+			const uint8_t *src = indices.data() + static_cast<size_t>(row) * frameW;
+			uint32_t *dst = canvas.data() + static_cast<size_t>(frameY + y) * width + frameX;
+			for (int x = 0; x < frameW; ++x) {
+				if (src[x] != transparent)
+					dst[x] = (*palette)[src[x]];
+			}
+		}
+
+		lastDisposal = disposal;
+		lastX = frameX;
+		lastY = frameY;
+		lastW = frameW;
+		lastH = frameH;
+
+		if (!fitted.empty() && !fitFrame())
+			return false;
+
+		frame.pixels = fitted.empty() ? canvas.data() : fitted.data();
+		frame.delay = delay;
+		hasDecodedFrame = true;
+
+		return true;
+	}
+
+	bool GifStream::fitFrame() {
+		PROFILE_ZONE("GifStream::fitFrame");
+
+		SDL_Surface *view = SDL_CreateRGBSurfaceWithFormatFrom(canvas.data(), width, height, 32, width * static_cast<int>(sizeof(uint32_t)), SDL_PIXELFORMAT_ARGB8888);
+		if (view == nullptr) {
+			std::cout << "Failed to wrap the gif canvas: " << SDL_GetError() << '\n';
+			return false;
+		}
+
+		// a frame is scaled every time it's decoded, the triangle filter keeps that cheap
+		SDL_Surface *surf = resampleCover(view, fitWidth, fitHeight, ResampleFilter::Bilinear);
+		SDL_FreeSurface(view);
+		if (surf == nullptr)
+			return false;
+
+		for (int y = 0; y < fitHeight; ++y)
+			std::memcpy(fitted.data() + static_cast<size_t>(y) * fitWidth, static_cast<const uint8_t *>(surf->pixels) + static_cast<size_t>(y) * surf->pitch, static_cast<size_t>(fitWidth) * sizeof(uint32_t));
+		freeSurface(surf);
+
+		return true;
+	}
+
+	bool GifStream::decodeLZW(int minCodeSize, std::vector<uint8_t> &out) {
+		if (minCodeSize < 2 || minCodeSize > 11)
+			return false;
+
+		constexpr int maxCodes = 4096;
+		// the table stores each code as (prefix code, last byte)
+		std::array<uint16_t, maxCodes> prefix {};
+		std::array<uint8_t, maxCodes> suffix {};
+		std::array<uint8_t, maxCodes + 1> stack {};
+
+		const int clearCode = 1 << minCodeSize;
+		const int endCode = clearCode + 1;
+		for (int i = 0; i < clearCode; ++i)
+			suffix[i] = static_cast<uint8_t>(i);
+
+		int codeSize = minCodeSize + 1;
+		int nextCode = endCode + 1;
+		int previous = -1;
+		uint8_t first = 0;
+
+		uint32_t bits = 0;
+		int bitCount = 0;
+		size_t written = 0;
+		uint8_t blockLeft = 0;
+		bool isDone = false;
+
+		while (!isDone) {
+			// refill the bit buffer from the sub-blocks
+			while (bitCount < codeSize) {
+				if (blockLeft == 0) {
+					blockLeft = readByte();
+					if (blockLeft == 0) {
+						// data ended before the end code, keep what we have
+						return true;
+					}
+				}
+				if (!hasBytes(1))
+					return false;
+
+				bits |= static_cast<uint32_t>(readByte()) << bitCount;
+				bitCount += 8;
+				--blockLeft;
+			}
+
+			const int code = static_cast<int>(bits & ((1u << codeSize) - 1));
+			bits >>= codeSize;
+			bitCount -= codeSize;
+
+			if (code == clearCode) {
+				codeSize = minCodeSize + 1;
+				nextCode = endCode + 1;
+				previous = -1;
+				continue;
+			}
+
+			if (code == endCode) {
+				isDone = true;
+				continue;
+			}
+
+			int current = code;
+			if (previous == -1) {
+				if (code >= clearCode)
+					return false;
+
+				if (written < out.size())
+					out[written++] = static_cast<uint8_t>(code);
+				first = static_cast<uint8_t>(code);
+				previous = code;
+				continue;
+			}
+
+			int top = 0;
+			if (code >= nextCode) {
+				// the KwKwK case: the code being defined right now
+				if (code > nextCode)
+					return false;
+				stack[top++] = first;
+				current = previous;
+			}
+
+			while (current >= clearCode) {
+				stack[top++] = suffix[current];
+				current = prefix[current];
+			}
+			stack[top++] = suffix[current];
+			first = suffix[current];
+
+			while (top > 0 && written < out.size())
+				out[written++] = stack[--top];
+
+			if (nextCode < maxCodes) {
+				prefix[nextCode] = static_cast<uint16_t>(previous);
+				suffix[nextCode] = first;
+				++nextCode;
+
+				if (nextCode == (1 << codeSize) && codeSize < 12)
+					++codeSize;
+			}
+
+			previous = code;
+		}
+
+		// skip whatever is left of the image data
+		if (blockLeft > 0) {
+			if (!hasBytes(blockLeft))
+				return false;
+			pos += blockLeft;
+		}
+
+		return skipSubBlocks();
+	}
+
+	const GifFrame *GifStream::current() const noexcept {
+		return hasDecodedFrame ? &frame : nullptr;
+	}
+
+	int GifStream::getWidth() const noexcept {
+		return fitted.empty() ? width : fitWidth;
+	}
+
+	int GifStream::getHeight() const noexcept {
+		return fitted.empty() ? height : fitHeight;
+	}
+} // namespace Application::Helper
\ No newline at end of file
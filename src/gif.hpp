@@ -0,0 +1,104 @@
+#pragma once
+
+#include "file.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** Structure
+ *
+ * GifFrame -> a fully composited frame (ARGB8888) and how long it stays on screen
+ * GifStream -> decodes an animated gif one frame at a time straight out of the mapped file
+ *
+ *	file --> [ indices ] --> canvas (composited) --> fitted (scaled down once per frame) --> current()
+ *
+ *  only the canvas (and the canvas a "previous" disposal restores) is kept at full size, never the whole animation
+ *  opened with a size, every frame is scaled down to cover it, so the texture & upload are that size instead of the gif's
+ *  screens & frames over maxPixels, or frames that don't fit on the screen, are refused before anything is allocated
+ */
+
+namespace Application::Helper {
+	struct GifFrame final {
+		// getWidth() x getHeight() pixels, valid until the next frame is decoded
+		const uint32_t *pixels {nullptr};
+		// milliseconds
+		int delay {0};
+	};
+
+	class GifStream final {
+	public:
+		// the largest logical screen accepted (a canvas of 16 MB)
+		static constexpr int64_t maxPixels {4'000'000};
+
+		/** Open a gif and decode its first frame.
+		 *
+		 * \param filePath -> the location of the gif
+		 * \param fitWidth -> (optional) the width frames are scaled down to cover
+		 * \param fitHeight -> (optional) the height frames are scaled down to cover
+		 * \return true if the file is a gif with at least one frame, otherwise false.
+		 */
+		bool open(std::string_view filePath, int fitWidth = 0, int fitHeight = 0);
+		/** Decode the next frame, the animation loops once it reaches the end.
+		 *
+		 * \return the decoded frame (valid until the next one is decoded) or nullptr if the data is corrupt.
+		 */
+		const GifFrame *next();
+		/** Gets the last decoded frame.
+		 *
+		 * \return the frame or nullptr if nothing was decoded.
+		 */
+		const GifFrame *current() const noexcept;
+		// the size of the frames handed out (the fitted size when the gif covers it)
+		int getWidth() const noexcept;
+		int getHeight() const noexcept;
+
+	private:
+		enum class Disposal : uint8_t {
+			None,
+			Keep,
+			Background,
+			Previous
+		};
+
+		bool readHeader();
+		bool decodeImage(Disposal disposal, int transparent, int delay);
+		bool decodeLZW(int minCodeSize, std::vector<uint8_t> &out);
+		bool skipSubBlocks();
+		uint8_t readByte() noexcept;
+		uint16_t readWord() noexcept;
+		bool hasBytes(size_t count) const noexcept;
+		void disposePrevious();
+		bool fitFrame();
+
+	private:
+		MappedFile file {};
+		size_t pos {0};
+		// where the first frame starts, used to loop
+		size_t firstFrame {0};
+		bool hasDecodedFrame {false};
+
+		int width {0};
+		int height {0};
+		std::array<uint32_t, 256> globalPalette {};
+		std::array<uint32_t, 256> localPalette {};
+		bool hasGlobalPalette {false};
+
+		// composited state & the state restored by Disposal::Previous
+		std::vector<uint32_t> canvas {};
+		std::vector<uint32_t> previousCanvas {};
+		std::vector<uint8_t> indices {};
+		// disposal of the frame that is currently on the canvas
+		Disposal lastDisposal {Disposal::None};
+		int lastX {0};
+		int lastY {0};
+		int lastW {0};
+		int lastH {0};
+
+		// the canvas scaled down to fitWidth x fitHeight (empty when it isn't fitted)
+		std::vector<uint32_t> fitted {};
+		int fitWidth {0};
+		int fitHeight {0};
+		GifFrame frame {};
+	};
+} // namespace Application::Helper
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include "image.hpp"
 #include "data.hpp"
+#include "profiler.hpp"
+#include "resample.hpp"
 #include "util.hpp"
+#include <cmath>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
 
@@ -11,38 +15,115 @@ namespace Application::Helper {
 			return nullptr;
 		}
 
-		return IMG_Load(filePath.data());
+		return trackSurface(IMG_Load(filePath.data()), MemoryTag::Image);
+	}
+
+	// bundle names always use '/'
+	static std::basic_string<char> toGenericPath(std::string_view path) {
+		std::basic_string<char> genericPath {path};
+		std::replace(genericPath.begin(), genericPath.end(), '\\', '/');
+		return genericPath;
+	}
+
+	bool Image::openBundle(std::string_view bundlePath, std::string_view rootPath) {
+		if (!bundle.open(bundlePath))
+			return false;
+
+		bundleRoot = toGenericPath(rootPath);
+		if (!bundleRoot.empty() && bundleRoot.back() != '/')
+			bundleRoot += '/';
+
+		// a bundle copied by hand can fall behind the files, it's only used while every entry still matches its source
+		for (const auto *entry : bundle.findAll("")) {
+			std::error_code error {};
+			const auto sourceSize = std::filesystem::file_size(bundleRoot + entry->name.data(), error);
+			if (error || sourceSize != entry->sourceSize) {
+				std::cout << "Bundle is stale (" << entry->name.data() << " changed), decoding files instead\n";
+				bundle.close();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	const BundleEntry *Image::findBundled(std::string_view filePath) const {
+		if (!bundle.isOpen())
+			return nullptr;
+
+		const auto path = toGenericPath(filePath);
+		if (!path.starts_with(bundleRoot))
+			return nullptr;
+
+		return bundle.find(std::string_view(path).substr(bundleRoot.size()));
+	}
+
+	IMD Image::createBundled(const BundleEntry &entry, std::string_view filePath, SDL_Renderer *ren, SDL_Color *key) {
+		IMD newImage = std::make_shared<ImageData>();
+		newImage->path = filePath;
+		newImage->imageWidth = static_cast<int>(entry.width);
+		newImage->imageHeight = static_cast<int>(entry.height);
+
+		if (key != nullptr) {
+			// colour keys need a surface, wrap the mapped pixels without copying them
+			SDL_Surface *surf = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<void *>(bundle.getPixels(entry)), newImage->imageWidth, newImage->imageHeight, 32, static_cast<int>(entry.pitch), bundle.getFormat());
+			if (surf == nullptr) {
+				std::cout << "Failed to wrap bundled image: " << SDL_GetError() << '\n';
+				return nullptr;
+			}
+			SDL_SetColorKey(surf, SDL_TRUE, SDL_MapRGB(surf->format, key->r, key->g, key->b));
+			newImage->texture = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTextureFromSurface(ren, surf), MemoryTag::Image));
+			freeSurface(surf);
+		} else {
+			newImage->texture = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTexture(ren, bundle.getFormat(), SDL_TEXTUREACCESS_STATIC, newImage->imageWidth, newImage->imageHeight), MemoryTag::Image));
+			if (newImage->texture != nullptr) {
+				SDL_SetTextureBlendMode(newImage->texture.get(), SDL_BLENDMODE_BLEND);
+				SDL_UpdateTexture(newImage->texture.get(), nullptr, bundle.getPixels(entry), static_cast<int>(entry.pitch));
+			}
+		}
+
+		if (newImage->texture == nullptr) {
+			std::cout << "Failed to create bundled image: " << SDL_GetError() << '\n';
+			return nullptr;
+		}
+
+		return cache.insert(TextureCache::getKey(filePath, key), newImage);
 	}
 
 	IMD Image::createImage(std::string_view filePath, SDL_Renderer *ren, SDL_Color *key) {
+		MemoryScope scope {MemoryTag::Image};
+		PROFILE_ZONE("Image::createImage");
+
+		const uint64_t cacheKey = TextureCache::getKey(filePath, key);
+		if (IMD cached = cache.find(cacheKey))
+			return cached; // we found the filePath
+
 		IMD newImage = std::make_shared<ImageData>();
 		newImage->path = filePath;
 
-		auto iter = images.find(filePath.data());
-		if (iter != images.end())
-			return iter->second; // we found the filePath
+		if (const BundleEntry *entry = findBundled(filePath))
+			return createBundled(*entry, filePath, ren, key);
 
 		SDL_Surface *surf = loadFile(filePath);
 
 		if (key != nullptr)
 			SDL_SetColorKey(surf, SDL_TRUE, SDL_MapRGB(surf->format, key->r, key->g, key->b));
 
-		newImage->texture = Utilities::PTR<SDL_Texture>(SDL_CreateTextureFromSurface(ren, surf));
+		newImage->texture = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTextureFromSurface(ren, surf), MemoryTag::Image));
 		if (newImage->texture == nullptr) {
 			std::cout << "Failed to create image: " << SDL_GetError() << '\n';
 			return nullptr;
 		}
-		images.insert({filePath.data(), newImage});
 
-		SDL_FreeSurface(surf);
+		freeSurface(surf);
 
-		return newImage;
+		return cache.insert(cacheKey, newImage);
 	}
 
 	IMD Image::createRenderTarget(SDL_Renderer *ren, unsigned int width, unsigned int height) {
 		IMD newImage = std::make_shared<ImageData>();
 
-		newImage->texture = Utilities::PTR<SDL_Texture>(SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height));
+		newImage->texture = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height), MemoryTag::Image));
 		if (newImage->texture == nullptr) {
 			std::cout << "Render Target failed to be created: " << SDL_GetError() << '\n';
 			return nullptr;
@@ -51,76 +132,262 @@ namespace Application::Helper {
 		return newImage;
 	}
 
+	Loader &Image::getLoader() {
+		if (loaderPtr == nullptr)
+			loaderPtr = std::make_unique<Loader>();
+
+		return *loaderPtr;
+	}
+
+	uint64_t Image::loadAsync(std::string_view filePath, SDL_Renderer *ren, std::function<void(IMD)> onLoaded, SDL_Color *key) {
+		PROFILE_ZONE("Image::loadAsync");
+
+		// nothing to decode, hand it over right away
+		if (const BundleEntry *entry = findBundled(filePath)) {
+			IMD img = cache.find(TextureCache::getKey(filePath, key));
+			if (img == nullptr)
+				img = createBundled(*entry, filePath, ren, key);
+			if (onLoaded)
+				onLoaded(img);
+			return 0;
+		}
+
+		std::optional<SDL_Color> colorKey {};
+		if (key != nullptr)
+			colorKey = *key;
+
+		const uint64_t ticket = getLoader().load(filePath, colorKey);
+		loadCallbacks.insert({ticket, std::move(onLoaded)});
+
+		return ticket;
+	}
+
+	uint64_t Image::loadFittedAsync(std::string_view filePath, int width, int height, std::function<void(IMD)> onLoaded) {
+		PROFILE_ZONE("Image::loadFittedAsync");
+
+		const uint64_t ticket = getLoader().loadFitted(filePath, width, height);
+		loadCallbacks.insert({ticket, std::move(onLoaded)});
+
+		return ticket;
+	}
+
+	uint64_t Image::loadGifAsync(std::string_view filePath, int width, int height, std::function<void(IMD)> onLoaded) {
+		PROFILE_ZONE("Image::loadGifAsync");
+
+		const uint64_t ticket = getLoader().loadGif(filePath, width, height);
+		loadCallbacks.insert({ticket, std::move(onLoaded)});
+
+		return ticket;
+	}
+
+	IMD Image::upload(LoadResult &result, SDL_Renderer *ren) {
+		MemoryScope scope {MemoryTag::Image};
+		PROFILE_ZONE("Image::upload");
+
+		if (result.gif != nullptr)
+			return createStream(std::move(result.gif), result.path, ren);
+
+		if (result.surface == nullptr)
+			return nullptr;
+
+		// the same file may have been loaded while this one was decoding (fitted images are never shared)
+		const bool isFitted = result.fit.x > 0;
+		const uint64_t cacheKey = TextureCache::getKey(result.path, result.key.has_value() ? &*result.key : nullptr);
+		if (IMD cached = isFitted ? nullptr : cache.find(cacheKey)) {
+			freeSurface(result.surface);
+			result.surface = nullptr;
+			return cached;
+		}
+
+		IMD newImage = std::make_shared<ImageData>();
+		newImage->path = result.path;
+		newImage->texture = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTextureFromSurface(ren, result.surface), MemoryTag::Image));
+		freeSurface(result.surface);
+		result.surface = nullptr;
+
+		if (newImage->texture == nullptr) {
+			std::cout << "Failed to create image: " << SDL_GetError() << '\n';
+			return nullptr;
+		}
+
+		if (isFitted)
+			return newImage;
+
+		return cache.insert(cacheKey, newImage);
+	}
+
+	void Image::dispatch(uint64_t ticket, IMD &img) {
+		auto iter = loadCallbacks.find(ticket);
+		if (iter == loadCallbacks.end())
+			return;
+
+		auto onLoaded = std::move(iter->second);
+		loadCallbacks.erase(iter);
+		if (onLoaded)
+			onLoaded(img);
+	}
+
+	int Image::update(SDL_Renderer *ren) {
+		if (loaderPtr == nullptr)
+			return 0;
+
+		int count = 0;
+		LoadResult result {};
+		while (loaderPtr->pop(result, false)) {
+			IMD img = upload(result, ren);
+			dispatch(result.ticket, img);
+			++count;
+		}
+
+		return count;
+	}
+
+	void Image::finish(SDL_Renderer *ren) {
+		if (loaderPtr == nullptr)
+			return;
+
+		LoadResult result {};
+		while (loaderPtr->pop(result, true)) {
+			IMD img = upload(result, ren);
+			dispatch(result.ticket, img);
+		}
+	}
+
 	IMD Image::createText(const MessageData &msg, SDL_Renderer *ren) {
+		MemoryScope scope {MemoryTag::Font};
+		PROFILE_ZONE("Image::createText");
+
+		const uint64_t cacheKey = TextureCache::getKey(msg, false);
+		if (IMD cached = cache.find(cacheKey))
+			return cached;
+
 		IMD newImage = std::make_shared<ImageData>();
 		newImage->path = msg.fontFile;
 
-		TTF_Font *font = TTF_OpenFont(msg.fontFile.data(), msg.fontSize);
-		if (font == nullptr) {
-			std::cout << "TTF_OpenFont error: " << TTF_GetError() << '\n';
+		TTF_Font *font = fontPtr->getFont({std::basic_string<char>(msg.fontFile), msg.fontSize});
+		if (font == nullptr)
 			return nullptr;
-		}
 
-		SDL_Surface *surf = TTF_RenderText_Blended(font, msg.msg.data(), msg.col.textColor);
+		SDL_Surface *surf = trackSurface(TTF_RenderText_Blended(font, std::basic_string<char>(msg.msg).c_str(), msg.col.textColor), MemoryTag::Font);
 		if (surf == nullptr) {
-			TTF_CloseFont(font);
 			std::cout << "TTF_RenderText error: " << TTF_GetError() << '\n';
 			return nullptr;
 		}
 
-		newImage->texture = Utilities::PTR<SDL_Texture>(SDL_CreateTextureFromSurface(ren, surf));
+		newImage->texture = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTextureFromSurface(ren, surf), MemoryTag::Font));
 		if (newImage->texture == nullptr) {
 			std::cout << "Text texture failed to be created: " << TTF_GetError() << '\n';
 			return nullptr;
 		}
-		images.insert({msg.fontFile, newImage});
 
-		SDL_FreeSurface(surf);
-		TTF_CloseFont(font);
+		freeSurface(surf);
 
-		return newImage;
+		return cache.insert(cacheKey, newImage);
 	}
 
 	IMD Image::createTextA(const MessageData &msg, SDL_Renderer *ren) {
+		MemoryScope scope {MemoryTag::Font};
+		PROFILE_ZONE("Image::createTextA");
+
+		const uint64_t cacheKey = TextureCache::getKey(msg, true);
+		if (IMD cached = cache.find(cacheKey))
+			return cached;
+
 		IMD newImage = std::make_shared<ImageData>();
+		newImage->path = msg.fontFile;
 
-		TTF_Font *font = TTF_OpenFont(msg.fontFile.data(), msg.fontSize);
-		if (font == nullptr) {
-			std::cout << "TTF_OpenFont error " << TTF_GetError() << "\n";
+		// shaded from the distance field like outlined runs, no second rasterization for the outline
+		TextRun run {};
+		if (!textPtr->shape(msg, ren, run, true) || run.texture == nullptr) {
+			std::cout << "Outline text texture failed to be created: " << SDL_GetError() << '\n';
 			return nullptr;
 		}
+		newImage->texture = std::move(run.texture);
+
+		return cache.insert(cacheKey, newImage);
+	}
+
+	bool Image::createText(const MessageData &msg, SDL_Renderer *ren, TextRun &run) {
+		return textPtr->shape(msg, ren, run);
+	}
 
-		TTF_Font *outlineFont = TTF_OpenFont(msg.fontFile.data(), msg.fontSize);
-		if (font == nullptr) {
-			std::cout << "TTF_OpenFont error " << TTF_GetError() << "\n";
+	bool Image::createTextA(const MessageData &msg, SDL_Renderer *ren, TextRun &run) {
+		return textPtr->shape(msg, ren, run, true);
+	}
+
+	IMD Image::createScaled(const IMD &img, int width, int height, SDL_Renderer *ren, ResampleFilter filter) {
+		MemoryScope scope {MemoryTag::Image};
+		PROFILE_ZONE("Image::createScaled");
+
+		if (img == nullptr || img->path.empty() || width <= 0 || height <= 0)
+			return nullptr;
+
+		const uint64_t cacheKey = TextureCache::getKey(img->path, width, height, filter);
+		if (unscalable.contains(cacheKey))
+			return nullptr;
+
+		if (IMD cached = cache.find(cacheKey))
+			return cached;
+
+		// streaming (gif) & target textures don't match their file anymore
+		int access = 0;
+		if (SDL_QueryTexture(img->texture.get(), nullptr, &access, nullptr, nullptr) != 0 || access != SDL_TEXTUREACCESS_STATIC) {
+			unscalable.insert(cacheKey);
 			return nullptr;
 		}
 
-		TTF_SetFontOutline(outlineFont, msg.outlineThickness);
+		SDL_Surface *surf = nullptr;
+		if (const BundleEntry *entry = findBundled(img->path))
+			surf = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<void *>(bundle.getPixels(*entry)), static_cast<int>(entry->width), static_cast<int>(entry->height), 32, static_cast<int>(entry->pitch), bundle.getFormat());
+		else
+			surf = loadFile(img->path);
+
+		SDL_Surface *scaled = resample(surf, nullptr, width, height, filter);
+		if (surf != nullptr)
+			freeSurface(surf);
 
-		SDL_Surface *bgSurf = TTF_RenderText_Blended(font, msg.msg.data(), msg.col.textColor);
-		SDL_Surface *fgSurf = TTF_RenderText_Blended(outlineFont, msg.msg.data(), {0x00, 0x00, 0x00});
+		if (scaled == nullptr) {
+			unscalable.insert(cacheKey);
+			return nullptr;
+		}
 
-		// destination rect that gets the size of the surface (explicit x/y for those that want to understand without digging)
-		SDL_Rect position = {position.x = 1, position.y = 1, fgSurf->w, fgSurf->h};
-		SDL_BlitSurface(bgSurf, nullptr, fgSurf, &position);
+		IMD newImage = std::make_shared<ImageData>();
+		newImage->path = img->path;
+		newImage->imageWidth = width;
+		newImage->imageHeight = height;
+		newImage->texture = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTextureFromSurface(ren, scaled), MemoryTag::Image));
+		freeSurface(scaled);
 
-		newImage->texture = Utilities::PTR<SDL_Texture>(SDL_CreateTextureFromSurface(ren, fgSurf));
 		if (newImage->texture == nullptr) {
-			std::cout << "Outline text texture failed to be created: " << TTF_GetError() << '\n';
+			std::cout << "Failed to create scaled image: " << SDL_GetError() << '\n';
+			unscalable.insert(cacheKey);
 			return nullptr;
 		}
-		images.insert({msg.fontFile, newImage});
 
-		SDL_FreeSurface(bgSurf);
-		SDL_FreeSurface(fgSurf);
-		TTF_CloseFont(outlineFont);
-		TTF_CloseFont(font);
+		return cache.insert(cacheKey, newImage);
+	}
 
-		return newImage;
+	// a scaled copy is drawn in place of its source, it has to look the same
+	static void copyTextureState(SDL_Texture *from, SDL_Texture *to) {
+		uint8_t r = 0xFF, g = 0xFF, b = 0xFF, a = 0xFF;
+		SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+		SDL_GetTextureColorMod(from, &r, &g, &b);
+		SDL_GetTextureAlphaMod(from, &a);
+		SDL_GetTextureBlendMode(from, &blendMode);
+
+		SDL_SetTextureColorMod(to, r, g, b);
+		SDL_SetTextureAlphaMod(to, a);
+		SDL_SetTextureBlendMode(to, blendMode);
 	}
 
-	void Image::draw(IMD &img, SDL_Renderer *ren, int x, int y, double sx, double sy, SDL_Rect *clip) noexcept {
+	void Image::draw(IMD &img, SDL_Renderer *ren, int x, int y, double sx, double sy, SDL_Rect *clip) {
+		// only the whole image has a scaled copy, a custom clip is scaled by the renderer
+		const bool isWhole = clip == nullptr;
+
+		// atlas regions only draw their part of the page
+		if (clip == nullptr && img->clip.w > 0)
+			clip = &img->clip;
+
 		SDL_Rect dst {x, y, NULL, NULL};
 		if (clip != nullptr) {
 			dst.w = clip->w;
@@ -129,35 +396,58 @@ namespace Application::Helper {
 			SDL_QueryTexture(img->texture.get(), nullptr, nullptr, &dst.w, &dst.h);
 		}
 
-		if ((sx && sy) != 0) {
-			dst.w *= static_cast<int>(sx);
-			dst.h *= static_cast<int>(sy);
+		if (sx != 0.0 && sy != 0.0) {
+			const int width = dst.w;
+			const int height = dst.h;
+			dst.w = static_cast<int>(std::lround(width * sx));
+			dst.h = static_cast<int>(std::lround(height * sy));
+
+			// the software renderer would resample every frame (nearest neighbour at that), the copy is resampled once
+			if (isWhole && (dst.w != width || dst.h != height)) {
+				if (IMD scaled = createScaled(img, dst.w, dst.h, ren)) {
+					copyTextureState(img->texture.get(), scaled->texture.get());
+					queuePtr->copy(ren, scaled->texture.get(), nullptr, dst);
+					// the cache may evict the copy before the queue is flushed
+					queuePtr->hold(scaled->texture);
+					return;
+				}
+			}
 		}
 
-		SDL_RenderCopy(ren, img->texture.get(), clip, &dst);
+		queuePtr->copy(ren, img->texture.get(), clip, dst);
+	}
+
+	void Image::draw(const TextRun &run, SDL_Renderer *ren, int x, int y) noexcept {
+		textPtr->draw(run, ren, x, y);
+	}
+
+	void Image::drawAnimation(uint32_t instance, SDL_Renderer *ren, int x, int y, double scale) const noexcept {
+		animPtr->draw(instance, ren, x, y, scale);
 	}
 
 	void Image::drawAnimation(IMD &img, SDL_Renderer *ren, int x, int y, double scale) const noexcept {
 		animPtr->draw(img, ren, x, y, scale);
 	}
 
+	void Image::drawAnimation(IMD &img, SDL_Renderer *ren, const SDL_Rect &dst) const noexcept {
+		animPtr->draw(img, ren, dst);
+	}
+
 	int Image::add(std::string_view str, IMD &img) {
-		auto iter = images.find(str.data());
-		if (iter != images.end()) {
+		const uint64_t cacheKey = TextureCache::getKey(str);
+		if (cache.find(cacheKey) != nullptr) {
 			std::cout << "Image already exists\n";
 			return -1;
-		} else {
-			images.insert({str.data(), img});
-			if (images.find(str.data()) != images.end())
-				std::cout << "Created image\n";
 		}
 
+		cache.insert(cacheKey, img);
+		std::cout << "Created image\n";
+
 		return 0;
 	}
 
 	int Image::remove(IMD &img) {
-		if (images.contains(img->path)) {
-			images.erase(img->path);
+		if (cache.remove(img)) {
 			img.reset();
 		} else {
 			std::cout << "Failed to remove image\n";
@@ -172,85 +462,257 @@ namespace Application::Helper {
 		SDL_SetTextureAlphaMod(img->texture.get(), col.a);
 	}
 
+	std::vector<IMD> Image::createAtlas(const std::vector<std::basic_string<char>> &filePaths, SDL_Renderer *ren, const std::vector<SDL_Point> &sizes) {
+		MemoryScope scope {MemoryTag::Image};
+		PROFILE_ZONE("Image::createAtlas");
+
+		struct Source final {
+			const BundleEntry *entry {nullptr};
+			SDL_Surface *surface {nullptr};
+			int width {0};
+			int height {0};
+			int region {-1};
+		};
+
+		std::vector<IMD> regions(filePaths.size(), nullptr);
+		std::vector<Source> sources(filePaths.size());
+		const auto getSize = [&sizes](size_t i) {
+			return i < sizes.size() && sizes[i].x > 0 && sizes[i].y > 0 ? sizes[i] : SDL_Point {0, 0};
+		};
+		// a resampled region isn't the file anymore, it's cached like any other scaled copy
+		const auto getRegionKey = [&](size_t i) {
+			const SDL_Point size = getSize(i);
+			return size.x > 0 ? TextureCache::getKey(filePaths[i], size.x, size.y, ResampleFilter::Lanczos) : TextureCache::getKey(filePaths[i]);
+		};
+
+		// bundled pixels are used as they are, everything else is decoded on the worker pool
+		std::unordered_map<uint64_t, size_t> tickets {};
+		for (size_t i = 0; i < filePaths.size(); ++i) {
+			if (IMD cached = cache.find(getRegionKey(i))) {
+				regions[i] = cached;
+			} else if (const BundleEntry *entry = findBundled(filePaths[i])) {
+				sources[i].entry = entry;
+				sources[i].width = static_cast<int>(entry->width);
+				sources[i].height = static_cast<int>(entry->height);
+			} else {
+				tickets.insert({getLoader().load(filePaths[i]), i});
+			}
+		}
+
+		LoadResult result {};
+		while (!tickets.empty() && getLoader().pop(result, true)) {
+			auto ticket = tickets.find(result.ticket);
+			if (ticket == tickets.end()) {
+				// someone else's load finished in between
+				IMD img = upload(result, ren);
+				dispatch(result.ticket, img);
+				continue;
+			}
+
+			Source &source = sources[ticket->second];
+			tickets.erase(ticket);
+			if (result.surface == nullptr)
+				continue;
+
+			source.surface = result.surface;
+			source.width = result.surface->w;
+			source.height = result.surface->h;
+		}
+
+		// regions drawn at a fixed size are scaled once here, the renderer would scale them every frame (nearest neighbour in software)
+		for (size_t i = 0; i < sources.size(); ++i) {
+			Source &source = sources[i];
+			const SDL_Point size = getSize(i);
+			if (source.width <= 0 || size.x <= 0 || (size.x == source.width && size.y == source.height))
+				continue;
+
+			SDL_Surface *surf = source.surface;
+			if (source.entry != nullptr)
+				surf = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<void *>(bundle.getPixels(*source.entry)), source.width, source.height, 32, static_cast<int>(source.entry->pitch), bundle.getFormat());
+
+			// the original is packed as it is when it can't be scaled
+			SDL_Surface *scaled = resample(surf, nullptr, size.x, size.y);
+			if (scaled == nullptr) {
+				if (source.entry != nullptr)
+					freeSurface(surf);
+				continue;
+			}
+
+			freeSurface(surf);
+			source.entry = nullptr;
+			source.surface = scaled;
+			source.width = size.x;
+			source.height = size.y;
+		}
+
+		// tallest first keeps the skyline flat
+		std::vector<size_t> order {};
+		for (size_t i = 0; i < sources.size(); ++i) {
+			if (sources[i].width > 0)
+				order.emplace_back(i);
+		}
+		std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {return sources[a].height > sources[b].height;});
+
+		Atlas atlas(ren);
+		for (size_t i : order)
+			sources[i].region = atlas.insert(sources[i].width, sources[i].height);
+
+		const bool isBuilt = !order.empty() && atlas.build(ren);
+		for (size_t i : order) {
+			Source &source = sources[i];
+			if (isBuilt && source.region != -1) {
+				const bool isUploaded = source.entry != nullptr
+					? atlas.upload(source.region, bundle.getPixels(*source.entry), static_cast<int>(source.entry->pitch))
+					: atlas.upload(source.region, source.surface);
+
+				if (isUploaded) {
+					regions[i] = atlas.getRegion(source.region);
+					regions[i]->path = filePaths[i];
+					cache.insert(getRegionKey(i), regions[i]);
+				} else {
+					std::cout << "Failed to upload atlas image: " << filePaths[i] << '\n';
+				}
+			}
+
+			if (source.surface != nullptr)
+				freeSurface(source.surface);
+		}
+
+		return regions;
+	}
+
 	IMD Image::createPack(std::string_view packName, std::string_view dirPath, SDL_Renderer *ren) {
+		MemoryScope scope {MemoryTag::Image};
+		PROFILE_ZONE("Image::createPack");
+
 		std::vector<std::basic_string<char>> pathList;
-		// get the directory path and append all of the files into the array
-		for (const auto &pathIter : std::filesystem::directory_iterator(dirPath)) {
-			auto pathString = pathIter.path().string();
-			const auto fixPathString = [&]() {
-				std::for_each(std::begin({pathString}), std::end({pathString}), [&](std::string_view str) {
-					if (pathString.find(str) != std::basic_string<char>::npos)
-						pathString.erase(std::remove(pathString.begin(), pathString.end(), '"'), pathString.end());
-				});
-			};
-			pathList.emplace_back(pathString);
-		}
-
-		int imageWidth = 0;
-		int imageHeight = 0;
-
-		// store a map containing the texture (loaded with the path)
-		IMD newImage = {nullptr};
-		for (const auto &path : pathList) {
-			newImage = createImage(path, ren);
-			SDL_QueryTexture(newImage->texture.get(), nullptr, nullptr, &newImage->imageWidth, &newImage->imageHeight);
-			imageWidth = newImage->imageWidth;
-			imageHeight = newImage->imageHeight;
-			imagePackList.insert({path, newImage});
-		}
-
-		// our 1D array is now prepped, now we need to align it on our atlas texture
-		IMD canvas = {nullptr};
-		// expand the width to create a large-width based canvas
-		canvas = createRenderTarget(ren, imageWidth * static_cast<unsigned int>(pathList.size()), imageHeight);
-
-		SDL_SetRenderTarget(ren, canvas->texture.get());
-		int iterWidth = 0; // the image iteration width (0, 148, 296, etc..)
-		bool firstElement = true; // to place the first image at origin
-		// unload our list onto the canvas
-		for (const auto &i : pathList) {
-			// place them sequentially on the canvas
-			if (firstElement) {
-				draw(imagePackList[i], ren, 0, 0);
-			} else {
-				draw(imagePackList[i], ren, iterWidth += imageWidth, 0);
+
+		const auto genericDirPath = toGenericPath(dirPath);
+		if (bundle.isOpen() && genericDirPath.starts_with(bundleRoot)) {
+			// the frames were baked, no need to touch the directory
+			for (const BundleEntry *entry : bundle.findAll(std::string_view(genericDirPath).substr(bundleRoot.size())))
+				pathList.emplace_back(bundleRoot + std::basic_string<char>(entry->name.data(), strnlen(entry->name.data(), entry->name.size())));
+		}
+
+		if (pathList.empty()) {
+			// get the directory path and append all of the files into the array
+			for (const auto &pathIter : std::filesystem::directory_iterator(dirPath)) {
+				auto pathString = toGenericPath(pathIter.path().string());
+				pathString.erase(std::remove(pathString.begin(), pathString.end(), '"'), pathString.end());
+				pathList.emplace_back(pathString);
 			}
-			firstElement = false;
+			// frame order follows the file names on every platform
+			std::sort(pathList.begin(), pathList.end());
+		}
+
+		std::vector<IMD> frames {};
+		for (auto &frame : createAtlas(pathList, ren)) {
+			if (frame == nullptr)
+				continue;
+
+			imagePackList.insert({frame->path, frame});
+			frames.emplace_back(std::move(frame));
+		}
+
+		if (frames.empty()) {
+			std::cout << "Failed to create pack: " << packName << '\n';
+			return nullptr;
 		}
-		SDL_SetRenderTarget(ren, nullptr);
-		// fill width and height for querying
+
+		// the canvas is the first page, kept so the pack can be queried like before
+		IMD canvas = std::make_shared<ImageData>();
+		canvas->path = packName;
+		canvas->texture = frames.front()->texture;
 		SDL_QueryTexture(canvas->texture.get(), nullptr, nullptr, &canvas->imageWidth, &canvas->imageHeight);
-		// add canvas to Image container
 		add(packName, canvas);
+		packFrames.insert_or_assign(std::basic_string<char>(packName), frames);
 
 		return canvas;
 	}
 
+	std::vector<IMD> Image::getPackFrames(std::string_view packName) const {
+		auto iter = packFrames.find(std::basic_string<char>(packName));
+		if (iter == packFrames.end()) {
+			std::cout << "Failed to get pack\n";
+			return {};
+		}
+
+		return iter->second;
+	}
+
+	IMD Image::createGif(std::string_view filePath, SDL_Renderer *ren) {
+		MemoryScope scope {MemoryTag::Animation};
+		PROFILE_ZONE("Image::createGif");
+
+		auto gif = std::make_shared<GifStream>();
+		if (!gif->open(filePath))
+			return nullptr;
+
+		return createStream(std::move(gif), filePath, ren);
+	}
+
+	IMD Image::createStream(std::shared_ptr<GifStream> gif, std::string_view filePath, SDL_Renderer *ren) {
+		MemoryScope scope {MemoryTag::Animation};
+
+		IMD newImage = std::make_shared<ImageData>();
+		newImage->path = filePath;
+		newImage->imageWidth = gif->getWidth();
+		newImage->imageHeight = gif->getHeight();
+
+		newImage->texture = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, gif->getWidth(), gif->getHeight()), MemoryTag::Animation));
+		if (newImage->texture == nullptr) {
+			std::cout << "Gif texture failed to be created: " << SDL_GetError() << '\n';
+			return nullptr;
+		}
+		SDL_SetTextureBlendMode(newImage->texture.get(), SDL_BLENDMODE_BLEND);
+
+		animPtr->setStream(std::move(gif), newImage);
+
+		return newImage;
+	}
+
 	int Image::getPackWidth(std::string_view packName) noexcept {
-		auto findPack = images.find(packName.data());
-		if (findPack == images.end()) {
+		IMD findPack = cache.find(TextureCache::getKey(packName));
+		if (findPack == nullptr) {
 			std::cout << "Failed to get pack\n";
 			return -1;
 		}
 
-		return images[packName.data()]->imageWidth;
+		return findPack->imageWidth;
 	}
 
 	int Image::getPackHeight(std::string_view packName) noexcept {
-		auto findPack = images.find(packName.data());
-		if (findPack == images.end()) {
+		IMD findPack = cache.find(TextureCache::getKey(packName));
+		if (findPack == nullptr) {
 			std::cout << "Failed to get pack\n";
 			return -1;
 		}
 
-		return images[packName.data()]->imageHeight;
+		return findPack->imageHeight;
 	}
 
 	std::shared_ptr<Animation> Image::getAnimPtr() noexcept {
 		return animPtr;
 	}
 
+	std::shared_ptr<RenderQueue> Image::getQueuePtr() noexcept {
+		return queuePtr;
+	}
+
+	std::shared_ptr<Text> Image::getTextPtr() noexcept {
+		return textPtr;
+	}
+
+	std::shared_ptr<FontCache> Image::getFontPtr() noexcept {
+		return fontPtr;
+	}
+
+	TextureCache &Image::getCache() noexcept {
+		return cache;
+	}
+
 	void Image::printImageCount() const noexcept {
-		std::cout << "Image Size: " << images.size() << '\n';
+		std::cout << "Image Size: " << cache.getStats().count << '\n';
+		cache.printStats();
 	}
 } // namespace Application::Helper
\ No newline at end of file
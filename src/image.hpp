@@ -4,21 +4,47 @@
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 #include "animation.hpp"
+#include "atlas.hpp"
+#include "bundle.hpp"
 #include "data.hpp"
+#include "font.hpp"
+#include "loader.hpp"
+#include "renderqueue.hpp"
+#include "text.hpp"
+#include "texturecache.hpp"
+#include <functional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 /** Structure
  *
  * ImageData -> has the texture we want to actually operate on (SDL_Texture)
  * IMD -> ImageData Smart Pointer
  * Image -> operates on ImageData (which contains an SDL_Texture and its related info)
- * Pack -> creates a texture atlas full of image objects and constructs them into a 1D array
+ * Atlas -> several images packed onto shared pages (see atlas.hpp), each one drawn through its clip
+ * Pack -> a directory of frames packed onto an atlas, played back as an animation clip (see animation.hpp)
+ * Gif -> a single streaming texture, each frame is decoded & uploaded when it's due (see gif.hpp)
+ * Async -> files are decoded on the loader's worker pool, the textures are created on the render thread
+ *          fitted loads are scaled down on the worker & aren't cached (the caller owns the only reference)
+ * Bundle -> prebaked pixels (see bundle.hpp), used before any file is decoded
+ * TextRun -> text shaped from the glyph atlas (see text.hpp), no texture is created per string
+ * RenderQueue -> every draw goes through the queue (see renderqueue.hpp), present it at the end of the frame
+ * TextureCache -> images & texts are cached by what they were made from (see texturecache.hpp), bounded by a byte budget
+ * Scaled -> images drawn at another size are resampled once per size (see resample.hpp), each frame is a plain copy
  */
 
 namespace Application::Helper {
 	class Image {
 	public:
+		/** Use a prebaked asset bundle, images inside of it are uploaded straight from the mapping.
+		 *
+		 * \param bundlePath -> the location of the bundle (built by tools/packer.cpp)
+		 * \param rootPath -> the directory the bundle was built from, file paths are looked up relative to it
+		 * \return true if the bundle was opened, otherwise false (everything is decoded from files instead).
+		 */
+		bool openBundle(std::string_view bundlePath, std::string_view rootPath);
 		/** Create an image to be used for rendering. You can add an colour to be set transparent.
 		 *
 		 * \param filePath -> the location of the image file
@@ -35,6 +61,35 @@ namespace Application::Helper {
 		 * \return the image to be used as a render target or nullptr if the operation failed.
 		 */
 		IMD createRenderTarget(SDL_Renderer *ren, unsigned int width, unsigned int height);
+		/** Decode an image on the worker pool, the texture is created by update or finish.
+		 *
+		 * \param filePath -> the location of the image file
+		 * \param ren -> the renderer to use (bundled images are uploaded right away)
+		 * \param onLoaded -> called on the render thread with the image (nullptr if the operation failed)
+		 * \param key -> the colour to be colour keyed
+		 * \return the ticket of the load (0 if it was already done).
+		 */
+		uint64_t loadAsync(std::string_view filePath, SDL_Renderer *ren, std::function<void(IMD)> onLoaded, SDL_Color *key = nullptr);
+		/** Decode an image on the worker pool & scale it down there to cover a size, meant for user files of any size.
+		 *
+		 * \param filePath -> the location of the image file
+		 * \param width -> the width to cover (pixels, the texture is never larger)
+		 * \param height -> the height to cover (pixels, the texture is never larger)
+		 * \param onLoaded -> called on the render thread with the image (nullptr if the operation failed)
+		 * \return the ticket of the load.
+		 */
+		uint64_t loadFittedAsync(std::string_view filePath, int width, int height, std::function<void(IMD)> onLoaded);
+		/** Upload every image that finished decoding without waiting for the rest.
+		 *
+		 * \param ren -> the renderer to use
+		 * \return the number of images that were uploaded.
+		 */
+		int update(SDL_Renderer *ren);
+		/** Wait for every queued image & upload them.
+		 *
+		 * \param ren -> the renderer to use
+		 */
+		void finish(SDL_Renderer *ren);
 		/** Create a text image.
 		 *
 		 * \param msg -> a struct constructed with:
@@ -59,14 +114,52 @@ namespace Application::Helper {
 		 * \return the text image with an outline or nullptr if the operation failed.
 		 */
 		IMD createTextA(const MessageData &msg, SDL_Renderer *ren);
+		/** Create text from the glyph atlas, only glyphs that were never drawn before get rasterized.
+		 *
+		 * \param msg -> a struct constructed with:
+		 * \param - msg -> the string of text
+		 * \param - fontFile -> the font file for the text
+		 * \param - col -> the colour of the text
+		 * \param - fontSize -> the size of the text
+		 * \param ren -> the renderer to use
+		 * \param run -> the text run to fill (reused between frames)
+		 * \return true if the run can be drawn, otherwise false.
+		 */
+		bool createText(const MessageData &msg, SDL_Renderer *ren, TextRun &run);
+		/** Create text with an outline, shaded from the distance field atlas (no glyph is rasterized per size or thickness).
+		 *
+		 * \param msg -> a struct constructed with:
+		 * \param - msg -> the string of text
+		 * \param - fontFile -> the font file for the text
+		 * \param - col -> the colour of the text
+		 * \param - fontSize -> the size of the text
+		 * \param - outlineThickness -> the thickness of the text outline
+		 * \param ren -> the renderer to use
+		 * \param run -> the text run to fill (reused between frames)
+		 * \return true if the run can be drawn, otherwise false.
+		 */
+		bool createTextA(const MessageData &msg, SDL_Renderer *ren, TextRun &run);
+		/** Create several images on shared atlas pages, decoding them in parallel.
+		 *  Images on the same page share a texture (and its colour mod).
+		 *
+		 * \param filePaths -> the locations of the image files
+		 * \param ren -> the renderer to use (limits the page size)
+		 * \param sizes -> (optional) the size each image is drawn at, resampled once before packing ({0, 0} keeps the file's size)
+		 * \return one image per file in the same order (nullptr for the files that failed).
+		 */
+		std::vector<IMD> createAtlas(const std::vector<std::basic_string<char>> &filePaths, SDL_Renderer *ren, const std::vector<SDL_Point> &sizes = {});
 		/** Create an Image Pack (texture atlas). 
 		 *
-		 *  extracted gif images are placed sequentially on the texture atlas
+		 *  extracted gif images are packed in 2D onto as few pages as the renderer allows
+		 *
+		 *	-----------------    -----------------
+		 *	| 0 | 1 | 2 | 3 |    | 8 | 9 |       |
+		 *	|---|---|---|---|    |---|---|       |
+		 *	| 4 | 5 | 6 | 7 |    |               |
+		 *	-----------------    -----------------
+		 *  frames may differ in size, a new page is started when one is full
 		 *
-		 *	-----------------------------
-		 *	| 0 | 1 | 2 | 3 | 4 | 5 | 6 |
-		 *	-----------------------------
-		 *  1D array: images are on an x axis only (rows)
+		 *  frames are decoded in parallel, use getPackFrames to animate them
 		 */
 
 		/** Packs the gif extraction into an atlas to be used as an animation
@@ -74,14 +167,58 @@ namespace Application::Helper {
 		 * \param packName -> the name of the image pack canvas that will be added to the map.
 		 * \param dirPath -> the directory of the files, not the actual files!
 		 * \param ren -> the renderer to use
-		 * \return the image (canvas) or nullptr if the operation failed.
+		 * \return the image (first page) or nullptr if the operation failed.
 		 */
 		IMD createPack(std::string_view packName, std::string_view dirPath, SDL_Renderer *ren);
+		/** Stream an animated gif, frames are decoded on demand one at a time instead of a pack.
+		 *  The image animation streams the gif from now on (see drawAnimation).
+		 *
+		 * \param filePath -> the location of the gif
+		 * \param ren -> the renderer to use
+		 * \return the streaming image (gif sized) or nullptr if the operation failed.
+		 */
+		IMD createGif(std::string_view filePath, SDL_Renderer *ren);
+		/** Open a gif on the worker pool (any file a user drops), every frame is scaled down to cover a size.
+		 *  The image animation streams the gif once it's uploaded by update or finish.
+		 *
+		 * \param filePath -> the location of the gif
+		 * \param width -> the width to cover (pixels, the texture is never larger)
+		 * \param height -> the height to cover (pixels, the texture is never larger)
+		 * \param onLoaded -> called on the render thread with the streaming image (nullptr if the operation failed)
+		 * \return the ticket of the load.
+		 */
+		uint64_t loadGifAsync(std::string_view filePath, int width, int height, std::function<void(IMD)> onLoaded);
 		/** Gets the animation pointer for adding & drawing animations.
 		 * 
 		 * \return the pointer associated with the image animation.
 		 */
 		std::shared_ptr<Animation> getAnimPtr() noexcept;
+		/** Gets the render queue every draw is submitted to.
+		 *
+		 * \return the pointer associated with the image queue.
+		 */
+		std::shared_ptr<RenderQueue> getQueuePtr() noexcept;
+		/** Gets the text pointer that owns the glyph atlas.
+		 *
+		 * \return the pointer associated with the image text.
+		 */
+		std::shared_ptr<Text> getTextPtr() noexcept;
+		/** Gets the font cache shared by every text path.
+		 *
+		 * \return the pointer associated with the image fonts.
+		 */
+		std::shared_ptr<FontCache> getFontPtr() noexcept;
+		/** Gets the cache every image & text texture goes through (budget & stats).
+		 *
+		 * \return the texture cache of the image.
+		 */
+		TextureCache &getCache() noexcept;
+		/** Gets the frames of an Image Pack in file order (see Animation::addClip).
+		 *
+		 * \param packName -> the name of the image that was packed
+		 * \return the frames or an empty list if the image pack was not found.
+		 */
+		std::vector<IMD> getPackFrames(std::string_view packName) const;
 		/** Gets the Image Pack width.
 		 *
 		 * \param packName -> the name of the image that was packed
@@ -107,25 +244,61 @@ namespace Application::Helper {
 		 * \return 0 if the operation succeeded, otherwise -1 if it failed.
 		 */
 		int remove(IMD &img);
+		/** Create a copy of an image resampled to a size, drawing it is a plain copy instead of scaling every frame.
+		 *  The source is decoded again from the bundle or its file, the copy is cached per size (colour keys aren't kept).
+		 *
+		 * \param img -> the image to scale (created from a file)
+		 * \param width -> the width of the copy
+		 * \param height -> the height of the copy
+		 * \param ren -> the renderer to use
+		 * \param filter -> the kernel to resample with
+		 * \return the scaled image or nullptr if img has no file to scale (texts, render targets, gifs) or the operation failed.
+		 */
+		IMD createScaled(const IMD &img, int width, int height, SDL_Renderer *ren, ResampleFilter filter = ResampleFilter::Lanczos);
 		/** Renders an image to the screen.
 		 * 
 		 * \param img -> the image to draw
 		 * \param ren -> the renderer to use
 		 * \param x -> x position of the image
 		 * \param y -> y position of the image
-		 * \param scale -> scale up or down the image width and height (0 if default)
+		 * \param scale -> scale up or down the image width and height, fractions included (0 if default)
+		 *                 a whole image is drawn from a copy made once per size (see createScaled)
 		 * \param clip -> the portion of the image to render (nullptr if default)
 		 */
-		void draw(IMD &img, SDL_Renderer *ren, int x, int y, double sx = 0.0, double sy = 0.0, SDL_Rect *clip = nullptr) noexcept;
-		/** Renders an animation (or GIF from Image Pack) to the screen.
+		void draw(IMD &img, SDL_Renderer *ren, int x, int y, double sx = 0.0, double sy = 0.0, SDL_Rect *clip = nullptr);
+		/** Renders a text run to the screen.
+		 *
+		 * \param run -> the text to draw
+		 * \param ren -> the renderer to use
+		 * \param x -> x position of the text
+		 * \param y -> y position of the text
+		 */
+		void draw(const TextRun &run, SDL_Renderer *ren, int x, int y) noexcept;
+		/** Renders an animation instance (e.g. a clip of an Image Pack) to the screen.
+		 *
+		 * \param instance -> the instance to draw (see Animation::play)
+		 * \param ren -> the renderer to use
+		 * \param x -> x position of the image
+		 * \param y -> y position of the image
+		 * \param scale -> scale up or down the image width and height (0 if default)
+		 */
+		void drawAnimation(uint32_t instance, SDL_Renderer *ren, int x, int y, double scale = 0) const noexcept;
+		/** Renders the streamed GIF to the screen.
 		 * 
-		 * \param img -> the image (animation) to draw
+		 * \param img -> the streaming image to draw (see createGif)
 		 * \param ren -> the renderer to use
 		 * \param x -> x position of the image
 		 * \param y -> y position of the image
 		 * \param scale -> scale up or down the image width and height (0 if default)
 		 */
 		void drawAnimation(IMD &img, SDL_Renderer *ren, int x, int y, double scale = 0) const noexcept;
+		/** Renders the streamed GIF to cover a rectangle (aspect ratio kept, the overflow is cropped around the centre).
+		 * 
+		 * \param img -> the streaming image to draw (see createGif)
+		 * \param ren -> the renderer to use
+		 * \param dst -> the rectangle to cover
+		 */
+		void drawAnimation(IMD &img, SDL_Renderer *ren, const SDL_Rect &dst) const noexcept;
 		/** Modifies the colour of the image.
 		 * 
 		 * \param img -> the image to modify
@@ -137,8 +310,28 @@ namespace Application::Helper {
 		void printImageCount() const noexcept;
 
 	private:
-		std::unordered_map<std::basic_string<char>, IMD> images {};
+		const BundleEntry *findBundled(std::string_view filePath) const;
+		IMD createBundled(const BundleEntry &entry, std::string_view filePath, SDL_Renderer *ren, SDL_Color *key);
+		Loader &getLoader();
+		IMD upload(LoadResult &result, SDL_Renderer *ren);
+		// creates the streaming texture of an opened gif & hands the gif to the animation
+		IMD createStream(std::shared_ptr<GifStream> gif, std::string_view filePath, SDL_Renderer *ren);
+		void dispatch(uint64_t ticket, IMD &img);
+
+	private:
+		TextureCache cache {};
 		std::unordered_map<std::basic_string<char>, IMD> imagePackList {};
-		std::shared_ptr<Animation> animPtr {std::make_shared<Animation>()};
+		std::unordered_map<std::basic_string<char>, std::vector<IMD>> packFrames {};
+		std::shared_ptr<RenderQueue> queuePtr {std::make_shared<RenderQueue>()};
+		std::shared_ptr<Animation> animPtr {std::make_shared<Animation>(queuePtr)};
+		std::shared_ptr<FontCache> fontPtr {std::make_shared<FontCache>()};
+		std::shared_ptr<Text> textPtr {std::make_shared<Text>(fontPtr, queuePtr)};
+		// started on the first asynchronous load
+		std::unique_ptr<Loader> loaderPtr {nullptr};
+		Bundle bundle {};
+		std::basic_string<char> bundleRoot {};
+		std::unordered_map<uint64_t, std::function<void(IMD)>> loadCallbacks {};
+		// scaled copies that can't be made, so a failing draw doesn't decode the file every frame
+		std::unordered_set<uint64_t> unscalable {};
 	};
 } // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "loader.hpp"
+#include "memstats.hpp"
+#include "profiler.hpp"
+#include "resample.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+
+namespace Application::Helper {
+	Loader::Loader(unsigned int threads, size_t capacity) : resultCapacity(std::max<size_t>(capacity, 1)) {
+		if (threads == 0) {
+			// leave a core for the render thread
+			const unsigned int cores = std::thread::hardware_concurrency();
+			threads = std::clamp(cores > 1 ? cores - 1 : 1u, 1u, 8u);
+		}
+
+		for (unsigned int i = 0; i < threads; ++i)
+			workers.emplace_back([this](std::stop_token token) {work(token);});
+	}
+
+	Loader::~Loader() {
+		for (auto &worker : workers)
+			worker.request_stop();
+		jobReady.notify_all();
+		resultFree.notify_all();
+		workers.clear();
+
+		for (auto &result : results)
+			freeSurface(result.surface);
+	}
+
+	uint64_t Loader::load(std::string_view filePath, std::optional<SDL_Color> key) {
+		return push({0, std::basic_string<char>(filePath), key});
+	}
+
+	uint64_t Loader::loadFitted(std::string_view filePath, int width, int height) {
+		return push({0, std::basic_string<char>(filePath), std::nullopt, {width, height}});
+	}
+
+	uint64_t Loader::loadGif(std::string_view filePath, int width, int height) {
+		return push({0, std::basic_string<char>(filePath), std::nullopt, {width, height}, true});
+	}
+
+	uint64_t Loader::push(Job job) {
+		uint64_t ticket = 0;
+		{
+			std::lock_guard lock(jobMutex);
+			ticket = nextTicket++;
+			job.ticket = ticket;
+			jobs.push_back(std::move(job));
+		}
+		{
+			std::lock_guard lock(resultMutex);
+			++pendingCount;
+		}
+		jobReady.notify_one();
+
+		return ticket;
+	}
+
+	bool Loader::pop(LoadResult &result, bool wait) {
+		std::unique_lock lock(resultMutex);
+		if (wait) {
+			resultReady.wait(lock, [this] {return !results.empty() || pendingCount == 0;});
+		}
+
+		if (results.empty())
+			return false;
+
+		result = std::move(results.front());
+		results.pop_front();
+		--pendingCount;
+		lock.unlock();
+
+		resultFree.notify_one();
+
+		return true;
+	}
+
+	size_t Loader::getPendingCount() const noexcept {
+		std::lock_guard lock(resultMutex);
+		return pendingCount;
+	}
+
+	uint32_t Loader::getWakeEvent() noexcept {
+		static const uint32_t wakeEvent = [] {
+			const uint32_t type = SDL_RegisterEvents(1);
+			if (type == static_cast<uint32_t>(-1)) {
+				std::cout << "Failed to register the loader's wake event\n";
+				return 0u;
+			}
+			return type;
+		}();
+
+		return wakeEvent;
+	}
+
+	static uint32_t readBE(const uint8_t *bytes, int count) {
+		uint32_t value = 0;
+		for (int i = 0; i < count; ++i)
+			value = value << 8 | bytes[i];
+		return value;
+	}
+
+	static uint32_t readLE(const uint8_t *bytes, int count) {
+		uint32_t value = 0;
+		for (int i = count - 1; i >= 0; --i)
+			value = value << 8 | bytes[i];
+		return value;
+	}
+
+	// the size from the header of a png, jpeg, gif or bmp, false for anything else (it's decoded without a check)
+	static bool probeSize(const std::basic_string<char> &filePath, int64_t &width, int64_t &height) {
+		std::ifstream file {filePath, std::ios::binary};
+		std::array<uint8_t, 26> header {};
+		if (!file.read(reinterpret_cast<char *>(header.data()), header.size()))
+			return false;
+
+		if (header[0] == 0x89 && header[1] == 'P' && header[2] == 'N' && header[3] == 'G') {
+			width = readBE(&header[16], 4);
+			height = readBE(&header[20], 4);
+			return true;
+		}
+
+		if (header[0] == 'G' && header[1] == 'I' && header[2] == 'F') {
+			width = readLE(&header[6], 2);
+			height = readLE(&header[8], 2);
+			return true;
+		}
+
+		if (header[0] == 'B' && header[1] == 'M') {
+			width = static_cast<int32_t>(readLE(&header[18], 4));
+			height = static_cast<int32_t>(readLE(&header[22], 4));
+			height = height < 0 ? -height : height;
+			return true;
+		}
+
+		if (header[0] == 0xFF && header[1] == 0xD8) {
+			// walk the segments up to the frame header
+			file.seekg(2);
+			std::array<uint8_t, 9> segment {};
+			while (file.read(reinterpret_cast<char *>(segment.data()), 4)) {
+				if (segment[0] != 0xFF)
+					return false;
+
+				const uint8_t marker = segment[1];
+				const uint32_t length = readBE(&segment[2], 2);
+				// SOF0 - SOF15, but not DHT (C4), JPG (C8) & DAC (CC)
+				if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+					if (!file.read(reinterpret_cast<char *>(&segment[4]), 5))
+						return false;
+					height = readBE(&segment[5], 2);
+					width = readBE(&segment[7], 2);
+					return true;
+				}
+
+				if (length < 2)
+					return false;
+				file.seekg(length - 2, std::ios::cur);
+			}
+		}
+
+		return false;
+	}
+
+	void Loader::work(std::stop_token token) {
+		MemoryScope scope {MemoryTag::Image};
+
+		while (!token.stop_requested()) {
+			Job job {};
+			{
+				std::unique_lock lock(jobMutex);
+				if (!jobReady.wait(lock, token, [this] {return !jobs.empty();}))
+					return;
+
+				job = std::move(jobs.front());
+				jobs.pop_front();
+			}
+
+			const bool isFitted = job.fit.x > 0 && job.fit.y > 0;
+			int64_t width = 0;
+			int64_t height = 0;
+			SDL_Surface *surf = nullptr;
+			std::shared_ptr<GifStream> gif {nullptr};
+			if (job.isGif) {
+				PROFILE_ZONE("Loader::openGif");
+				MemoryScope gifScope {MemoryTag::Animation};
+				gif = std::make_shared<GifStream>();
+				if (!gif->open(job.path, job.fit.x, job.fit.y))
+					gif.reset();
+			} else if (isFitted && probeSize(job.path, width, height) && width * height > maxFitPixels) {
+				std::cout << "Image is too large (" << width << "x" << height << "): " << job.path << '\n';
+			} else {
+				PROFILE_ZONE("Loader::decode");
+				surf = trackSurface(IMG_Load(job.path.c_str()), MemoryTag::Image);
+				if (surf == nullptr)
+					std::cout << "Failed to load file: " << job.path << ", " << IMG_GetError() << '\n';
+			}
+
+			if (surf != nullptr && job.key.has_value())
+				SDL_SetColorKey(surf, SDL_TRUE, SDL_MapRGB(surf->format, job.key->r, job.key->g, job.key->b));
+
+			// the full size surface is gone before the next job is decoded (smaller images are stretched by the renderer)
+			if (surf != nullptr && isFitted) {
+				PROFILE_ZONE("Loader::fit");
+				if (SDL_Surface *fitted = resampleCover(surf, job.fit.x, job.fit.y)) {
+					freeSurface(surf);
+					surf = fitted;
+				}
+			}
+
+			// wait for the render thread to catch up when the queue is full
+			std::unique_lock lock(resultMutex);
+			if (!resultFree.wait(lock, token, [this] {return results.size() < resultCapacity;})) {
+				freeSurface(surf);
+				return;
+			}
+
+			results.push_back({job.ticket, std::move(job.path), surf, job.key, job.fit, std::move(gif)});
+			lock.unlock();
+
+			resultReady.notify_one();
+
+			// wake the render thread up if it's sleeping in SDL_WaitEventTimeout
+			if (const uint32_t type = getWakeEvent(); type != 0) {
+				SDL_Event wake {};
+				wake.type = type;
+				SDL_PushEvent(&wake);
+			}
+		}
+	}
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include "gif.hpp"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** Structure
+ *
+ * Loader -> decodes image files into SDL_Surfaces on a pool of worker threads
+ *
+ *	load() --> [ jobs ] --> worker 0..n (IMG_Load) --> [ bounded results ] --> pop() on the render thread
+ *
+ *  surfaces are handed back in the order they finish, the render thread uploads them (textures can't
+ *  be created off-thread). workers stop decoding while the results queue is full.
+ *  every result pushes a getWakeEvent event, it only wakes the render thread & isn't input
+ *  a job with a size to fit is scaled down on the worker (see resample.hpp), only the small surface is queued,
+ *  files that would decode past maxFitPixels are refused from their header before anything is decoded
+ *  a gif job opens a GifStream instead (header & first frame), the render thread only creates its texture
+ */
+
+namespace Application::Helper {
+	struct LoadResult final {
+		uint64_t ticket {0};
+		std::basic_string<char> path {};
+		// owned by whoever pops the result, nullptr if decoding failed
+		SDL_Surface *surface {nullptr};
+		// the colour that was colour keyed
+		std::optional<SDL_Color> key {};
+		// the size the surface was scaled to cover ({0, 0} when it wasn't)
+		SDL_Point fit {0, 0};
+		// the opened stream of a loadGif job (nullptr if it failed or the job was an image)
+		std::shared_ptr<GifStream> gif {nullptr};
+	};
+
+	class Loader final {
+	public:
+		/** Start the worker pool.
+		 *
+		 * \param threads -> the number of workers (0 picks one per core, minus the render thread)
+		 * \param capacity -> how many decoded surfaces can wait for upload at once
+		 */
+		explicit Loader(unsigned int threads = 0, size_t capacity = 16);
+		// larger images aren't decoded to be fitted, the surface alone would be ~100 MB
+		static constexpr int64_t maxFitPixels {32'000'000};
+
+		Loader(const Loader &) = delete;
+		Loader &operator=(const Loader &) = delete;
+		~Loader();
+
+		/** Queue a file to be decoded.
+		 *
+		 * \param filePath -> the location of the image file
+		 * \param key -> (optional) the colour to be colour keyed
+		 * \return the ticket of the job, matched by LoadResult::ticket.
+		 */
+		uint64_t load(std::string_view filePath, std::optional<SDL_Color> key = std::nullopt);
+		/** Queue a file to be decoded & scaled down to cover a size (aspect ratio kept, centred).
+		 *
+		 * \param filePath -> the location of the image file
+		 * \param width -> the width to cover
+		 * \param height -> the height to cover
+		 * \return the ticket of the job, matched by LoadResult::ticket.
+		 */
+		uint64_t loadFitted(std::string_view filePath, int width, int height);
+		/** Queue a gif to be opened & its first frame decoded, every frame is scaled down to cover a size.
+		 *
+		 * \param filePath -> the location of the gif
+		 * \param width -> the width to cover
+		 * \param height -> the height to cover
+		 * \return the ticket of the job, matched by LoadResult::ticket.
+		 */
+		uint64_t loadGif(std::string_view filePath, int width, int height);
+		/** Take a decoded surface off the queue.
+		 *
+		 * \param result -> receives the ticket, path & surface (the caller frees the surface)
+		 * \param wait -> block until a result is available (returns false right away when nothing is queued)
+		 * \return true if a result was taken, otherwise false.
+		 */
+		bool pop(LoadResult &result, bool wait);
+		/** Gets the number of jobs that were queued but not popped yet.
+		 */
+		size_t getPendingCount() const noexcept;
+		/** Gets the event type workers push when a result is ready (to wake a render thread waiting for events).
+		 *
+		 * \return the type, registered with SDL the first time, or 0 if SDL ran out of event types (nothing is pushed then).
+		 */
+		static uint32_t getWakeEvent() noexcept;
+
+	private:
+		struct Job final {
+			uint64_t ticket {0};
+			std::basic_string<char> path {};
+			std::optional<SDL_Color> key {};
+			SDL_Point fit {0, 0};
+			bool isGif {false};
+		};
+
+		uint64_t push(Job job);
+		void work(std::stop_token token);
+
+	private:
+		mutable std::mutex jobMutex {};
+		std::condition_variable_any jobReady {};
+		std::deque<Job> jobs {};
+
+		mutable std::mutex resultMutex {};
+		std::condition_variable_any resultReady {};
+		std::condition_variable_any resultFree {};
+		std::deque<LoadResult> results {};
+		size_t resultCapacity {16};
+
+		uint64_t nextTicket {1};
+		size_t pendingCount {0};
+
+		// declared last so the workers are stopped before the queues go away
+		std::vector<std::jthread> workers {};
+	};
+} // namespace Application::Helper
\ No newline at end of file
@@ -1,9 +1,9 @@
 #include "anya.hpp"
 
 using namespace Application;
-int main(int, char **)
+int main(int argc, char **argv)
 {
-	auto inst = Anya();
+	auto inst = Anya(argc, argv);
 
 	return 0;
 }
\ No newline at end of file
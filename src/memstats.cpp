@@ -0,0 +1,287 @@
+#include "memstats.hpp"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+namespace Application::Helper {
+	struct Counter final {
+		std::atomic<int64_t> bytes {0};
+		std::atomic<int64_t> peak {0};
+		std::atomic<int64_t> count {0};
+		std::atomic<int64_t> total {0};
+	};
+
+	constexpr size_t tagCount {static_cast<size_t>(MemoryTag::Count)};
+	constexpr size_t kindCount {static_cast<size_t>(MemoryKind::Count)};
+
+	// constant initialized, operator new can run before any other static
+	static constinit std::array<std::array<Counter, tagCount>, kindCount> counters {};
+	static constinit std::atomic<int64_t> budget {0};
+	static constinit thread_local MemoryTag heapTag {MemoryTag::Other};
+
+	// textures & surfaces remember what they were counted as, their size can't be queried once they are gone
+	struct Tracked final {
+		MemoryTag tag {MemoryTag::Other};
+		int64_t bytes {0};
+	};
+
+	static std::mutex &getTrackedMutex() {
+		static std::mutex trackedMutex {};
+		return trackedMutex;
+	}
+
+	static std::unordered_map<const void *, Tracked> &getTracked() {
+		static std::unordered_map<const void *, Tracked> tracked {};
+		return tracked;
+	}
+
+	static Counter &getCounter(MemoryKind kind, MemoryTag tag) noexcept {
+		return counters[static_cast<size_t>(kind)][static_cast<size_t>(tag)];
+	}
+
+	static void add(MemoryKind kind, MemoryTag tag, int64_t bytes) noexcept {
+		Counter &counter = getCounter(kind, tag);
+		const int64_t now = counter.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+		counter.count.fetch_add(1, std::memory_order_relaxed);
+		counter.total.fetch_add(1, std::memory_order_relaxed);
+
+		int64_t peak = counter.peak.load(std::memory_order_relaxed);
+		while (now > peak && !counter.peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+	}
+
+	static void sub(MemoryKind kind, MemoryTag tag, int64_t bytes) noexcept {
+		Counter &counter = getCounter(kind, tag);
+		counter.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+		counter.count.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	static void track(MemoryKind kind, const void *object, MemoryTag tag, int64_t bytes) {
+		{
+			std::lock_guard lock(getTrackedMutex());
+			auto [iter, isInserted] = getTracked().insert({object, {tag, bytes}});
+			if (!isInserted)
+				return;
+		}
+		add(kind, tag, bytes);
+	}
+
+	static void untrack(MemoryKind kind, const void *object) {
+		Tracked tracked {};
+		{
+			std::lock_guard lock(getTrackedMutex());
+			auto iter = getTracked().find(object);
+			if (iter == getTracked().end())
+				return;
+
+			tracked = iter->second;
+			getTracked().erase(iter);
+		}
+		sub(kind, tracked.tag, tracked.bytes);
+	}
+
+	MemoryScope::MemoryScope(MemoryTag tag) noexcept : previous(heapTag) {
+		heapTag = tag;
+	}
+
+	MemoryScope::~MemoryScope() {
+		heapTag = previous;
+	}
+
+	std::string_view getMemoryTagName(MemoryTag tag) noexcept {
+		switch (tag) {
+			case MemoryTag::Image: return "Image";
+			case MemoryTag::Animation: return "Animation";
+			case MemoryTag::UInterface: return "UInterface";
+			case MemoryTag::Font: return "Font";
+			default: return "Other";
+		}
+	}
+
+	size_t getTextureBytes(SDL_Texture *texture) noexcept {
+		uint32_t format = 0;
+		int w = 0;
+		int h = 0;
+		if (texture == nullptr || SDL_QueryTexture(texture, &format, nullptr, &w, &h) != 0)
+			return 0;
+
+		// packed & planar formats report 0, count them like 32 bit pixels
+		const size_t bytesPerPixel = SDL_BYTESPERPIXEL(format) > 0 ? SDL_BYTESPERPIXEL(format) : 4;
+
+		return static_cast<size_t>(w) * h * bytesPerPixel;
+	}
+
+	SDL_Texture *trackTexture(SDL_Texture *texture, MemoryTag tag) {
+		if (texture != nullptr)
+			track(MemoryKind::Texture, texture, tag, static_cast<int64_t>(getTextureBytes(texture)));
+
+		return texture;
+	}
+
+	void untrackTexture(SDL_Texture *texture) {
+		if (texture != nullptr)
+			untrack(MemoryKind::Texture, texture);
+	}
+
+	SDL_Surface *trackSurface(SDL_Surface *surface, MemoryTag tag) {
+		// surfaces wrapping someone else's pixels (SDL_PREALLOC) don't own any memory
+		if (surface != nullptr && !(surface->flags & SDL_PREALLOC))
+			track(MemoryKind::Surface, surface, tag, static_cast<int64_t>(surface->pitch) * surface->h);
+
+		return surface;
+	}
+
+	void freeSurface(SDL_Surface *surface) {
+		if (surface == nullptr)
+			return;
+
+		untrack(MemoryKind::Surface, surface);
+		SDL_FreeSurface(surface);
+	}
+
+	MemoryUsage getMemoryUsage(MemoryKind kind, MemoryTag tag) noexcept {
+		const Counter &counter = getCounter(kind, tag);
+		return {
+			counter.bytes.load(std::memory_order_relaxed),
+			counter.peak.load(std::memory_order_relaxed),
+			counter.count.load(std::memory_order_relaxed),
+			counter.total.load(std::memory_order_relaxed)
+		};
+	}
+
+	int64_t getMemoryTotal() noexcept {
+		int64_t total = 0;
+		for (const auto &kind : counters) {
+			for (const auto &counter : kind)
+				total += counter.bytes.load(std::memory_order_relaxed);
+		}
+
+		return total;
+	}
+
+	int64_t getAllocationCount() noexcept {
+		int64_t total = 0;
+		for (const auto &counter : counters[static_cast<size_t>(MemoryKind::Heap)])
+			total += counter.total.load(std::memory_order_relaxed);
+
+		return total;
+	}
+
+	void setMemoryBudget(int64_t bytes) noexcept {
+		budget.store(bytes, std::memory_order_relaxed);
+	}
+
+	int64_t getMemoryBudget() noexcept {
+		return budget.load(std::memory_order_relaxed);
+	}
+
+	bool isOverMemoryBudget() noexcept {
+		const int64_t limit = getMemoryBudget();
+		return limit > 0 && getMemoryTotal() > limit;
+	}
+
+	std::basic_string<char> dumpMemory() {
+		constexpr std::array<std::string_view, kindCount> kindNames {"texture", "surface", "heap"};
+
+		std::basic_string<char> json = std::format("{{\"total\": {}, \"budget\": {}", getMemoryTotal(), getMemoryBudget());
+		for (size_t kind = 0; kind < kindCount; ++kind) {
+			json += std::format(", \"{}\": {{", kindNames[kind]);
+			for (size_t tag = 0; tag < tagCount; ++tag) {
+				const MemoryUsage usage = getMemoryUsage(static_cast<MemoryKind>(kind), static_cast<MemoryTag>(tag));
+				json += std::format("{}\"{}\": {{\"bytes\": {}, \"peak\": {}, \"count\": {}}}", tag == 0 ? "" : ", ", getMemoryTagName(static_cast<MemoryTag>(tag)), usage.bytes, usage.peak, usage.count);
+			}
+			json += '}';
+		}
+		json += '}';
+
+		return json;
+	}
+
+	bool dumpMemory(std::string_view filePath) {
+		std::ofstream file {std::basic_string<char>(filePath)};
+		if (!file) {
+			std::cout << "Failed to write memory dump: " << filePath << '\n';
+			return false;
+		}
+
+		file << dumpMemory() << '\n';
+
+		return true;
+	}
+
+	// heap blocks start with their size & tag, the pointer handed out stays aligned for any type
+	struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) HeapHeader final {
+		size_t size {0};
+		MemoryTag tag {MemoryTag::Other};
+	};
+
+	static void *allocate(size_t size) noexcept {
+		auto *header = static_cast<HeapHeader *>(std::malloc(sizeof(HeapHeader) + size));
+		if (header == nullptr)
+			return nullptr;
+
+		header->size = size;
+		header->tag = heapTag;
+		add(MemoryKind::Heap, header->tag, static_cast<int64_t>(size));
+
+		return header + 1;
+	}
+
+	static void deallocate(void *ptr) noexcept {
+		if (ptr == nullptr)
+			return;
+
+		auto *header = static_cast<HeapHeader *>(ptr) - 1;
+		sub(MemoryKind::Heap, header->tag, static_cast<int64_t>(header->size));
+		std::free(header);
+	}
+} // namespace Application::Helper
+
+// counting allocator hook, over-aligned allocations keep using the default operators
+void *operator new(size_t size) {
+	if (void *ptr = Application::Helper::allocate(size))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+	return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+	return Application::Helper::allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+	return Application::Helper::allocate(size);
+}
+
+void operator delete(void *ptr) noexcept {
+	Application::Helper::deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	Application::Helper::deallocate(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	Application::Helper::deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+	Application::Helper::deallocate(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+	Application::Helper::deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+	Application::Helper::deallocate(ptr);
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <string>
+
+/** Structure
+ *
+ * MemoryTag -> the subsystem memory is counted for
+ * MemoryKind -> textures (queried format & size), surfaces (transient, the peak matters) & heap (operator new)
+ * MemoryScope -> heap allocations on this thread are counted for a subsystem until the scope ends
+ *
+ *	          Image   Animation   UInterface   Font   Other
+ *	Texture   [   ]   [       ]   [        ]   [  ]   [   ]   <- bytes, peak & live count of every cell
+ *	Surface   [   ]   [       ]   [        ]   [  ]   [   ]
+ *	Heap      [   ]   [       ]   [        ]   [  ]   [   ]
+ */
+
+namespace Application::Helper {
+	enum class MemoryTag : uint8_t {
+		Image,
+		Animation,
+		UInterface,
+		Font,
+		Other,
+		Count
+	};
+
+	enum class MemoryKind : uint8_t {
+		Texture,
+		Surface,
+		Heap,
+		Count
+	};
+
+	struct MemoryUsage final {
+		int64_t bytes {0};
+		int64_t peak {0};
+		// live textures, surfaces or allocations
+		int64_t count {0};
+		// every texture, surface or allocation made so far (allocations per frame for the benchmark)
+		int64_t total {0};
+	};
+
+	class MemoryScope final {
+	public:
+		explicit MemoryScope(MemoryTag tag) noexcept;
+		MemoryScope(const MemoryScope &) = delete;
+		MemoryScope &operator=(const MemoryScope &) = delete;
+		~MemoryScope();
+
+	private:
+		MemoryTag previous {MemoryTag::Other};
+	};
+
+	std::string_view getMemoryTagName(MemoryTag tag) noexcept;
+	/** Gets how many bytes a texture takes from its format & size.
+	 *
+	 * \param texture -> the texture to query
+	 * \return the size in bytes or 0 if the texture can't be queried.
+	 */
+	size_t getTextureBytes(SDL_Texture *texture) noexcept;
+	/** Count a texture until it's destroyed (Utilities::Memory untracks it).
+	 *
+	 * \param texture -> the created texture (nullptr is ignored)
+	 * \param tag -> the subsystem that owns it
+	 * \return the texture.
+	 */
+	SDL_Texture *trackTexture(SDL_Texture *texture, MemoryTag tag);
+	void untrackTexture(SDL_Texture *texture);
+	/** Count a surface until it's freed with freeSurface.
+	 *
+	 * \param surface -> the created surface (nullptr is ignored)
+	 * \param tag -> the subsystem that owns it
+	 * \return the surface.
+	 */
+	SDL_Surface *trackSurface(SDL_Surface *surface, MemoryTag tag);
+	// untracks & frees a surface (untracked surfaces are only freed)
+	void freeSurface(SDL_Surface *surface);
+
+	MemoryUsage getMemoryUsage(MemoryKind kind, MemoryTag tag) noexcept;
+	// bytes of every texture, surface & heap allocation that is alive
+	int64_t getMemoryTotal() noexcept;
+	// heap allocations made so far by every subsystem
+	int64_t getAllocationCount() noexcept;
+	// 0 disables the budget
+	void setMemoryBudget(int64_t bytes) noexcept;
+	int64_t getMemoryBudget() noexcept;
+	bool isOverMemoryBudget() noexcept;
+	/** Dump every counter as JSON.
+	 *
+	 * \return {"total": .., "budget": .., "texture": {"Image": {"bytes": .., "peak": .., "count": ..}, ..}, "surface": {..}, "heap": {..}}
+	 */
+	std::basic_string<char> dumpMemory();
+	/** Write the JSON dump to a file.
+	 *
+	 * \param filePath -> the location of the file
+	 * \return true if the file was written, otherwise false.
+	 */
+	bool dumpMemory(std::string_view filePath);
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "pacer.hpp"
+#include <algorithm>
+#include <thread>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+namespace Application::Helper {
+	FramePacer::FramePacer(double rate, std::chrono::microseconds spin) : spin(spin) {
+		setTargetRate(rate);
+		deadline = Clock::now();
+
+#ifdef _WIN32
+		timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+	}
+
+	FramePacer::~FramePacer() {
+#ifdef _WIN32
+		if (timer != nullptr)
+			CloseHandle(timer);
+#endif
+	}
+
+	void FramePacer::setTargetRate(double rate) {
+		const auto newPeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / std::max(rate, 0.001)));
+		if (newPeriod == period)
+			return;
+
+		// keep the last frame as the reference point
+		deadline += newPeriod - period;
+		period = newPeriod;
+	}
+
+	void FramePacer::setSpin(std::chrono::microseconds spin) noexcept {
+		this->spin = spin;
+	}
+
+	double FramePacer::getTargetRate() const noexcept {
+		return 1.0 / std::chrono::duration<double>(period).count();
+	}
+
+	FramePacer::Clock::duration FramePacer::getPeriod() const noexcept {
+		return period;
+	}
+
+	FramePacer::Clock::duration FramePacer::getTimeToDeadline() const noexcept {
+		return std::max(Clock::duration::zero(), deadline - Clock::now());
+	}
+
+	bool FramePacer::isDue() const noexcept {
+		return Clock::now() >= deadline;
+	}
+
+	void FramePacer::sleepUntil(Clock::time_point time) {
+		const auto now = Clock::now();
+		if (time <= now)
+			return;
+
+#ifdef _WIN32
+		if (timer != nullptr) {
+			// negative due times are relative, in 100ns units
+			LARGE_INTEGER dueTime {};
+			dueTime.QuadPart = -std::max<long long>(1, std::chrono::duration_cast<std::chrono::nanoseconds>(time - now).count() / 100);
+			if (SetWaitableTimerEx(timer, &dueTime, 0, nullptr, nullptr, nullptr, 0)) {
+				WaitForSingleObject(timer, INFINITE);
+				return;
+			}
+		}
+#endif
+		std::this_thread::sleep_until(time);
+	}
+
+	void FramePacer::waitForDeadline() {
+		const auto start = Clock::now();
+
+		sleepUntil(deadline - spin);
+		while (Clock::now() < deadline)
+			std::this_thread::yield();
+
+		sleepTime = Clock::now() - start;
+	}
+
+	void FramePacer::beginFrame() noexcept {
+		frameStart = Clock::now();
+	}
+
+	void FramePacer::endFrame() noexcept {
+		const auto end = Clock::now();
+		workTime = end - frameStart;
+
+		// a frame that started within a period of its deadline keeps the cadence (waking up late doesn't drift),
+		// anything else was idle or drawn early & starts a new schedule
+		const bool isOnSchedule = frameStart >= deadline && frameStart - deadline < period;
+		deadline = (isOnSchedule ? deadline : frameStart) + period;
+
+		if (end > deadline) {
+			++missedDeadlines;
+			deadline = end;
+		}
+	}
+
+	int FramePacer::getMissedDeadlines() const noexcept {
+		return missedDeadlines;
+	}
+
+	FramePacer::Clock::duration FramePacer::getWorkTime() const noexcept {
+		return workTime;
+	}
+
+	FramePacer::Clock::duration FramePacer::getSleepTime() const noexcept {
+		return sleepTime;
+	}
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+
+/** Structure
+ *
+ * FramePacer -> decides when the next frame may be presented & sleeps precisely until then
+ *
+ *	| work | sleep      | work   | sleep    | work ...
+ *	^ deadline         ^ deadline          ^ deadline      (deadline n + 1 = deadline n + period)
+ *
+ *  work & sleep are measured separately, so a long frame doesn't shorten the next one's budget
+ *  a frame that ends after the following deadline is a miss, the schedule restarts from there (no catch-up burst)
+ *  waking up is done with a high resolution sleep, the last microseconds can be spun if configured
+ */
+
+namespace Application::Helper {
+	class FramePacer final {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/** Create a pacer.
+		 *
+		 * \param rate -> the target frames per second
+		 * \param spin -> how long before the deadline sleeping stops & spinning starts (0 to never spin)
+		 */
+		explicit FramePacer(double rate = 30.0, std::chrono::microseconds spin = std::chrono::microseconds(0));
+		~FramePacer();
+		FramePacer(const FramePacer &) = delete;
+		FramePacer &operator=(const FramePacer &) = delete;
+
+		/** Change the target rate, the pending deadline moves with it.
+		 *
+		 * \param rate -> the target frames per second
+		 */
+		void setTargetRate(double rate);
+		void setSpin(std::chrono::microseconds spin) noexcept;
+		double getTargetRate() const noexcept;
+		Clock::duration getPeriod() const noexcept;
+		/** Gets the time left until the next frame is due.
+		 *
+		 * \return the time left or 0 if the frame is due.
+		 */
+		Clock::duration getTimeToDeadline() const noexcept;
+		bool isDue() const noexcept;
+		/** Sleep (then spin) until the next frame is due.
+		 */
+		void waitForDeadline();
+		/** Mark the start of a frame's work.
+		 */
+		void beginFrame() noexcept;
+		/** Mark the end of a frame's work (after presenting) & schedule the next deadline.
+		 */
+		void endFrame() noexcept;
+		int getMissedDeadlines() const noexcept;
+		// the last frame's work & the last wait
+		Clock::duration getWorkTime() const noexcept;
+		Clock::duration getSleepTime() const noexcept;
+
+	private:
+		void sleepUntil(Clock::time_point time);
+
+	private:
+		Clock::duration period {};
+		std::chrono::microseconds spin {0};
+		Clock::time_point deadline {};
+		Clock::time_point frameStart {};
+		Clock::duration workTime {};
+		Clock::duration sleepTime {};
+		int missedDeadlines {0};
+#ifdef _WIN32
+		// high resolution waitable timer (Sleep only has the resolution of the system tick)
+		void *timer {nullptr};
+#endif
+	};
+} // namespace Application::Helper
\ No newline at end of file
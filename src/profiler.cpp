@@ -0,0 +1,198 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace Application::Helper {
+	struct ZoneEvent final {
+		const char *name {nullptr};
+		int64_t start {0};
+		int64_t end {0};
+	};
+
+	// single writer (the owning thread), the exporter only reads up to the published head
+	struct ThreadBuffer final {
+		static constexpr size_t capacity {8192};
+
+		std::array<ZoneEvent, capacity> events {};
+		std::atomic<uint64_t> head {0};
+		uint32_t thread {0};
+		// where the last frame of this thread ended (see endProfileFrame)
+		uint64_t frameStart {0};
+	};
+
+	// rolling window of per-frame times
+	struct PhaseWindow final {
+		static constexpr size_t capacity {240};
+
+		std::array<double, capacity> samples {};
+		size_t next {0};
+		size_t count {0};
+	};
+
+	static constexpr uint64_t exportMargin {256};
+
+	static const auto profileEpoch = std::chrono::steady_clock::now();
+
+	static std::mutex &getRegistryMutex() {
+		static std::mutex registryMutex {};
+		return registryMutex;
+	}
+
+	// buffers are never freed, zones of threads that already exited can still be exported
+	static std::vector<std::unique_ptr<ThreadBuffer>> &getBuffers() {
+		static std::vector<std::unique_ptr<ThreadBuffer>> buffers {};
+		return buffers;
+	}
+
+	// transparent, looking a zone name up doesn't copy it
+	static std::map<std::basic_string<char>, PhaseWindow, std::less<>> &getPhases() {
+		static std::map<std::basic_string<char>, PhaseWindow, std::less<>> phases {};
+		return phases;
+	}
+
+	static ThreadBuffer &getThreadBuffer() {
+		static thread_local ThreadBuffer *buffer = [] {
+			std::lock_guard lock(getRegistryMutex());
+			auto &buffers = getBuffers();
+			buffers.emplace_back(std::make_unique<ThreadBuffer>());
+			buffers.back()->thread = static_cast<uint32_t>(buffers.size() - 1);
+			return buffers.back().get();
+		}();
+
+		return *buffer;
+	}
+
+	static void addSample(PhaseWindow &window, double sample) noexcept {
+		window.samples[window.next] = sample;
+		window.next = (window.next + 1) % PhaseWindow::capacity;
+		window.count = std::min(window.count + 1, PhaseWindow::capacity);
+	}
+
+	static double getPercentile(std::vector<double> &samples, double percentile) {
+		if (samples.empty())
+			return 0.0;
+
+		const size_t rank = std::min(samples.size() - 1, static_cast<size_t>(percentile * static_cast<double>(samples.size())));
+		std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+		return samples[rank];
+	}
+
+	ProfileScope::ProfileScope(const char *name) noexcept : name(name), start(getProfileTime()) {}
+
+	ProfileScope::~ProfileScope() {
+		recordZone(name, start, getProfileTime());
+	}
+
+	int64_t getProfileTime() noexcept {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - profileEpoch).count();
+	}
+
+	void recordZone(const char *name, int64_t start, int64_t end) noexcept {
+		ThreadBuffer &buffer = getThreadBuffer();
+		const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+		buffer.events[head % ThreadBuffer::capacity] = {name, start, end};
+		buffer.head.store(head + 1, std::memory_order_release);
+	}
+
+	void endProfileFrame() {
+		ThreadBuffer &buffer = getThreadBuffer();
+		const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+		// zones that were overwritten before the frame ended are lost
+		const uint64_t first = std::max(buffer.frameStart, head > ThreadBuffer::capacity ? head - ThreadBuffer::capacity : 0);
+
+		// keyed by the zone names themselves, the same literal can still live at two addresses (one per translation unit)
+		static thread_local std::vector<std::pair<const char *, double>> frameTimes {};
+		const auto findTime = [](const char *name) {
+			return std::ranges::find_if(frameTimes, [name](const auto &entry) {
+				return entry.first == name || std::strcmp(entry.first, name) == 0;
+			});
+		};
+		const auto addTime = [&findTime](const char *name, double time) {
+			if (const auto iter = findTime(name); iter != frameTimes.end())
+				iter->second += time;
+			else
+				frameTimes.emplace_back(name, time);
+		};
+
+		frameTimes.clear();
+		for (uint64_t i = first; i < head; ++i) {
+			const ZoneEvent &event = buffer.events[i % ThreadBuffer::capacity];
+			addTime(event.name, static_cast<double>(event.end - event.start) / 1'000'000.0);
+		}
+
+		static thread_local int64_t lastFrame = getProfileTime();
+		const int64_t now = getProfileTime();
+		addTime("Frame", static_cast<double>(now - lastFrame) / 1'000'000.0);
+		lastFrame = now;
+		buffer.frameStart = head;
+
+		std::lock_guard lock(getRegistryMutex());
+		auto &phases = getPhases();
+		// zones that didn't run this frame took no time
+		for (auto &[name, window] : phases) {
+			const auto iter = findTime(name.c_str());
+			addSample(window, iter != frameTimes.end() ? iter->second : 0.0);
+		}
+		// a name is only copied the first frame it shows up
+		for (const auto &[name, time] : frameTimes) {
+			if (!phases.contains(name))
+				addSample(phases.try_emplace(name).first->second, time);
+		}
+	}
+
+	std::vector<PhaseTiming> getPhaseTimings() {
+		std::lock_guard lock(getRegistryMutex());
+
+		std::vector<PhaseTiming> timings {};
+		for (const auto &[name, window] : getPhases()) {
+			std::vector<double> samples(window.samples.begin(), window.samples.begin() + window.count);
+			const double p50 = getPercentile(samples, 0.5);
+			const double p99 = getPercentile(samples, 0.99);
+			timings.push_back({name, p50, p99});
+		}
+
+		return timings;
+	}
+
+	void printPhaseTimings() {
+		for (const auto &timing : getPhaseTimings())
+			std::cout << std::format("{:<16} p50 {:8.3f}ms  p99 {:8.3f}ms\n", timing.name, timing.p50, timing.p99);
+	}
+
+	bool writeTrace(std::string_view filePath) {
+		std::ofstream file {std::basic_string<char>(filePath)};
+		if (!file) {
+			std::cout << "Failed to write trace: " << filePath << '\n';
+			return false;
+		}
+
+		file << "{\"traceEvents\": [";
+		bool isFirst = true;
+
+		std::lock_guard lock(getRegistryMutex());
+		for (const auto &buffer : getBuffers()) {
+			const uint64_t head = buffer->head.load(std::memory_order_acquire);
+			// other threads keep recording, the oldest slots may be overwritten while they're read so they are skipped
+			const uint64_t first = head > ThreadBuffer::capacity ? head - ThreadBuffer::capacity + exportMargin : 0;
+			for (uint64_t i = first; i < head; ++i) {
+				const ZoneEvent event = buffer->events[i % ThreadBuffer::capacity];
+				// complete events, timestamps are in microseconds
+				file << std::format("{}\n{{\"name\": \"{}\", \"ph\": \"X\", \"pid\": 1, \"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}}}",
+					isFirst ? "" : ",", event.name, buffer->thread, static_cast<double>(event.start) / 1000.0, static_cast<double>(event.end - event.start) / 1000.0);
+				isFirst = false;
+			}
+		}
+		file << "\n], \"displayTimeUnit\": \"ms\"}\n";
+
+		return true;
+	}
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** Structure
+ *
+ * PROFILE_ZONE -> times the rest of the scope, compiled out unless TIME_PROFILE is defined (debug builds define it)
+ * PROFILE_END_FRAME -> closes the frame of the calling thread (see endProfileFrame), compiled out with the zones
+ * ThreadBuffer -> every thread writes its zones into its own ring, no locks are taken while recording
+ * PhaseTiming -> rolling p50/p99 of every zone over the last frames (see endProfileFrame)
+ *
+ *	thread 0 [ Events | UInterface | Draw | Present | ... ]   <- oldest zones are overwritten
+ *	thread 1 [ Decode | Decode | ... ]
+ *
+ *  writeTrace exports the rings as Chrome trace_event JSON (chrome://tracing or ui.perfetto.dev)
+ */
+
+#if defined(_DEBUG) && !defined(TIME_PROFILE)
+#define TIME_PROFILE
+#endif
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef TIME_PROFILE
+#define PROFILE_ZONE(name) const Application::Helper::ProfileScope PROFILE_CONCAT(profileZone, __LINE__) {name}
+#define PROFILE_END_FRAME() Application::Helper::endProfileFrame()
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_END_FRAME() ((void)0)
+#endif
+
+namespace Application::Helper {
+	class ProfileScope final {
+	public:
+		// name has to outlive the trace (a string literal)
+		explicit ProfileScope(const char *name) noexcept;
+		ProfileScope(const ProfileScope &) = delete;
+		ProfileScope &operator=(const ProfileScope &) = delete;
+		~ProfileScope();
+
+	private:
+		const char *name {nullptr};
+		int64_t start {0};
+	};
+
+	struct PhaseTiming final {
+		std::basic_string<char> name {};
+		// milliseconds spent in the zone per frame
+		double p50 {0.0};
+		double p99 {0.0};
+	};
+
+	// nanoseconds since the profiler started
+	int64_t getProfileTime() noexcept;
+	void recordZone(const char *name, int64_t start, int64_t end) noexcept;
+	/** Close the frame of the calling thread, the time of every zone it recorded since the last call is added to the rolling timings.
+	 */
+	void endProfileFrame();
+	/** Gets the rolling timings of every zone (and the whole frame) over the last frames.
+	 *
+	 * \return the timings sorted by name.
+	 */
+	std::vector<PhaseTiming> getPhaseTimings();
+	void printPhaseTimings();
+	/** Write every recorded zone as Chrome trace_event JSON.
+	 *
+	 * \param filePath -> the location of the file
+	 * \return true if the file was written, otherwise false.
+	 */
+	bool writeTrace(std::string_view filePath);
+} // namespace Application::Helper
\ No newline at end of file
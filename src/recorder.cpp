@@ -0,0 +1,180 @@
+#include "recorder.hpp"
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+namespace Application::Helper {
+	bool EventRecorder::open(std::string_view filePath) {
+		file.open(std::basic_string<char>(filePath), std::ios::trunc);
+		if (!file) {
+			std::cout << "Failed to open the trace: " << filePath << '\n';
+			return false;
+		}
+
+		file << "# time event trace: <tick> <type> <fields>\n";
+
+		return true;
+	}
+
+	bool EventRecorder::isOpen() const noexcept {
+		return file.is_open();
+	}
+
+	void EventRecorder::record(uint64_t tick, const std::vector<SDL_Event> &events) {
+		if (!file.is_open())
+			return;
+
+		for (const auto &ev : events) {
+			switch (ev.type) {
+				case SDL_MOUSEMOTION: {
+					file << tick << " motion " << ev.motion.x << ' ' << ev.motion.y << ' ' << ev.motion.xrel << ' ' << ev.motion.yrel << '\n';
+				} break;
+
+				case SDL_MOUSEBUTTONDOWN:
+				case SDL_MOUSEBUTTONUP: {
+					file << tick << (ev.type == SDL_MOUSEBUTTONDOWN ? " down " : " up ") << static_cast<int>(ev.button.button) << ' ' << ev.button.x << ' ' << ev.button.y << '\n';
+				} break;
+
+				case SDL_MOUSEWHEEL: {
+					file << tick << " wheel " << ev.wheel.x << ' ' << ev.wheel.y << '\n';
+				} break;
+
+				case SDL_KEYDOWN:
+				case SDL_KEYUP: {
+					file << tick << (ev.type == SDL_KEYDOWN ? " keydown " : " keyup ") << ev.key.keysym.sym << ' ' << ev.key.keysym.mod << '\n';
+				} break;
+
+				case SDL_TEXTINPUT: {
+					file << tick << " text " << ev.text.text << '\n';
+				} break;
+
+				case SDL_DROPFILE: {
+					if (ev.drop.file != nullptr)
+						file << tick << " drop " << ev.drop.file << '\n';
+				} break;
+
+				case SDL_QUIT: {
+					file << tick << " quit\n";
+				} break;
+			}
+		}
+
+		// a crash should still leave the trace up to the last iteration
+		if (!events.empty())
+			file.flush();
+	}
+
+	// the rest of the line after the single separating space
+	static std::basic_string<char> getRest(std::basic_istringstream<char> &line) {
+		std::basic_string<char> rest {};
+		line.get();
+		std::getline(line, rest);
+
+		return rest;
+	}
+
+	bool EventReplayer::open(std::string_view filePath) {
+		std::ifstream file {std::basic_string<char>(filePath)};
+		if (!file) {
+			std::cout << "Failed to open the trace: " << filePath << '\n';
+			return false;
+		}
+
+		events.clear();
+		next = 0;
+
+		std::basic_string<char> text {};
+		int lineNumber = 0;
+		while (std::getline(file, text)) {
+			++lineNumber;
+			if (text.empty() || text.front() == '#')
+				continue;
+
+			std::basic_istringstream<char> line {text};
+			RecordedEvent recorded {};
+			std::basic_string<char> type {};
+			line >> recorded.tick >> type;
+
+			SDL_Event &ev = recorded.ev;
+			if (type == "motion") {
+				ev.type = SDL_MOUSEMOTION;
+				line >> ev.motion.x >> ev.motion.y >> ev.motion.xrel >> ev.motion.yrel;
+			} else if (type == "down" || type == "up") {
+				int button = 0;
+				ev.type = type == "down" ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+				line >> button >> ev.button.x >> ev.button.y;
+				ev.button.button = static_cast<uint8_t>(button);
+				ev.button.state = type == "down" ? SDL_PRESSED : SDL_RELEASED;
+				ev.button.clicks = 1;
+			} else if (type == "wheel") {
+				ev.type = SDL_MOUSEWHEEL;
+				line >> ev.wheel.x >> ev.wheel.y;
+			} else if (type == "keydown" || type == "keyup") {
+				int sym = 0;
+				int mod = 0;
+				ev.type = type == "keydown" ? SDL_KEYDOWN : SDL_KEYUP;
+				line >> sym >> mod;
+				ev.key.keysym.sym = static_cast<SDL_Keycode>(sym);
+				ev.key.keysym.scancode = SDL_GetScancodeFromKey(ev.key.keysym.sym);
+				ev.key.keysym.mod = static_cast<uint16_t>(mod);
+				ev.key.state = type == "keydown" ? SDL_PRESSED : SDL_RELEASED;
+			} else if (type == "text") {
+				ev.type = SDL_TEXTINPUT;
+				const auto text = getRest(line);
+				// SDL splits longer input into several events as well
+				std::strncpy(ev.text.text, text.c_str(), SDL_TEXTINPUTEVENT_TEXT_SIZE - 1);
+			} else if (type == "drop") {
+				ev.type = SDL_DROPFILE;
+				recorded.file = getRest(line);
+			} else if (type == "quit") {
+				ev.type = SDL_QUIT;
+			} else {
+				std::cout << "Unknown trace event (" << filePath << ':' << lineNumber << "): " << type << '\n';
+				continue;
+			}
+
+			if (line.fail()) {
+				std::cout << "Malformed trace event (" << filePath << ':' << lineNumber << ")\n";
+				continue;
+			}
+
+			events.emplace_back(std::move(recorded));
+		}
+
+		return true;
+	}
+
+	size_t EventReplayer::push(uint64_t tick) {
+		size_t pushed = 0;
+
+		for (; next < events.size() && events[next].tick <= tick; ++next) {
+			SDL_Event ev = events[next].ev;
+			ev.common.timestamp = SDL_GetTicks();
+
+			// the app asks SDL for the modifiers (ctrl+c/v), not the event
+			if (ev.type == SDL_KEYDOWN || ev.type == SDL_KEYUP)
+				SDL_SetModState(static_cast<SDL_Keymod>(ev.key.keysym.mod));
+			// handlers free the dropped path with SDL_free
+			if (ev.type == SDL_DROPFILE)
+				ev.drop.file = SDL_strdup(events[next].file.c_str());
+
+			if (SDL_PushEvent(&ev) != 1) {
+				std::cout << "Failed to push a trace event: " << SDL_GetError() << '\n';
+				if (ev.type == SDL_DROPFILE)
+					SDL_free(ev.drop.file);
+				continue;
+			}
+			++pushed;
+		}
+
+		return pushed;
+	}
+
+	bool EventReplayer::isFinished() const noexcept {
+		return next >= events.size();
+	}
+
+	uint64_t EventReplayer::getLastTick() const noexcept {
+		return events.empty() ? 0 : events.back().tick;
+	}
+} // namespace Application::Helper
\ No newline at end of file
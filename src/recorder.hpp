@@ -0,0 +1,76 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** Structure
+ *
+ * EventRecorder -> writes the events of every loop iteration to a trace (--record=<file>)
+ * EventReplayer -> pushes a trace back into SDL's queue, each event on the iteration it was recorded on (--replay=<file>)
+ *
+ *	<tick> motion <x> <y> <xrel> <yrel>
+ *	<tick> down|up <button> <x> <y>
+ *	<tick> wheel <x> <y>
+ *	<tick> keydown|keyup <sym> <mod>
+ *	<tick> text <utf8 up to the end of the line>
+ *	<tick> drop <path up to the end of the line>
+ *	<tick> quit
+ *
+ *  the tick is the loop iteration, so a replay is independent of how long each frame took
+ *  lines starting with # are comments, window events aren't recorded (the app causes them itself)
+ */
+
+namespace Application::Helper {
+	class EventRecorder final {
+	public:
+		/** Start a trace, an existing file is overwritten.
+		 *
+		 * \param filePath -> the location of the trace
+		 * \return true if the file could be opened, otherwise false.
+		 */
+		bool open(std::string_view filePath);
+		bool isOpen() const noexcept;
+		/** Append the events of a loop iteration.
+		 *
+		 * \param tick -> the loop iteration
+		 * \param events -> the events handled on that iteration
+		 */
+		void record(uint64_t tick, const std::vector<SDL_Event> &events);
+
+	private:
+		std::ofstream file {};
+	};
+
+	class EventReplayer final {
+	public:
+		/** Read a whole trace.
+		 *
+		 * \param filePath -> the location of the trace
+		 * \return true if the trace was read, otherwise false (malformed lines are skipped).
+		 */
+		bool open(std::string_view filePath);
+		/** Push every event recorded for a loop iteration, call it before the events are polled.
+		 *
+		 * \param tick -> the loop iteration
+		 * \return the number of events pushed.
+		 */
+		size_t push(uint64_t tick);
+		bool isFinished() const noexcept;
+		// the iteration of the last event (0 for an empty trace)
+		uint64_t getLastTick() const noexcept;
+
+	private:
+		struct RecordedEvent final {
+			uint64_t tick {0};
+			SDL_Event ev {};
+			// dropped files are copied for SDL when they are pushed
+			std::basic_string<char> file {};
+		};
+
+		std::vector<RecordedEvent> events {};
+		size_t next {0};
+	};
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "renderqueue.hpp"
+#include <iostream>
+#include <utility>
+
+namespace Application::Helper {
+	void RenderQueue::beginBatch(SDL_Renderer *ren, SDL_Texture *texture, SDL_BlendMode blendMode) {
+		if (!vertices.empty() && texture == batchTexture && blendMode == batchBlendMode)
+			return;
+
+		flush(ren);
+		batchTexture = texture;
+		batchBlendMode = blendMode;
+
+		textureWidth = 1;
+		textureHeight = 1;
+		if (texture != nullptr)
+			SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+	}
+
+	void RenderQueue::pushQuad(const SDL_FRect &dst, const SDL_FRect &uv, SDL_Color col) {
+		const int first = static_cast<int>(vertices.size());
+
+		vertices.push_back({{dst.x, dst.y}, col, {uv.x, uv.y}});
+		vertices.push_back({{dst.x + dst.w, dst.y}, col, {uv.x + uv.w, uv.y}});
+		vertices.push_back({{dst.x + dst.w, dst.y + dst.h}, col, {uv.x + uv.w, uv.y + uv.h}});
+		vertices.push_back({{dst.x, dst.y + dst.h}, col, {uv.x, uv.y + uv.h}});
+
+		for (int index : {0, 1, 2, 0, 2, 3})
+			indices.emplace_back(first + index);
+	}
+
+	void RenderQueue::copy(SDL_Renderer *ren, SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect &dst) {
+		if (texture == nullptr)
+			return;
+
+		SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+		SDL_GetTextureBlendMode(texture, &blendMode);
+		beginBatch(ren, texture, blendMode);
+
+		// SDL_RenderGeometry ignores the texture modulation that SDL_RenderCopy applies, so it goes into the vertices
+		SDL_Color col {255, 255, 255, 255};
+		SDL_GetTextureColorMod(texture, &col.r, &col.g, &col.b);
+		SDL_GetTextureAlphaMod(texture, &col.a);
+
+		SDL_FRect uv {0.0f, 0.0f, 1.0f, 1.0f};
+		if (src != nullptr) {
+			uv = {
+				static_cast<float>(src->x) / static_cast<float>(textureWidth),
+				static_cast<float>(src->y) / static_cast<float>(textureHeight),
+				static_cast<float>(src->w) / static_cast<float>(textureWidth),
+				static_cast<float>(src->h) / static_cast<float>(textureHeight)
+			};
+		}
+
+		pushQuad({static_cast<float>(dst.x), static_cast<float>(dst.y), static_cast<float>(dst.w), static_cast<float>(dst.h)}, uv, col);
+	}
+
+	void RenderQueue::fillRect(SDL_Renderer *ren, const SDL_Rect &rect, SDL_Color col) {
+		SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+		SDL_GetRenderDrawBlendMode(ren, &blendMode);
+		beginBatch(ren, nullptr, blendMode);
+
+		pushQuad({static_cast<float>(rect.x), static_cast<float>(rect.y), static_cast<float>(rect.w), static_cast<float>(rect.h)}, {0.0f, 0.0f, 0.0f, 0.0f}, col);
+	}
+
+	void RenderQueue::drawRect(SDL_Renderer *ren, const SDL_Rect &rect, SDL_Color col) {
+		if (rect.w <= 0 || rect.h <= 0)
+			return;
+
+		// four edges that don't overlap, so blended corners aren't drawn twice
+		fillRect(ren, {rect.x, rect.y, rect.w, 1}, col);
+		if (rect.h > 1)
+			fillRect(ren, {rect.x, rect.y + rect.h - 1, rect.w, 1}, col);
+		if (rect.h > 2) {
+			fillRect(ren, {rect.x, rect.y + 1, 1, rect.h - 2}, col);
+			if (rect.w > 1)
+				fillRect(ren, {rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2}, col);
+		}
+	}
+
+	void RenderQueue::hold(std::shared_ptr<SDL_Texture> texture) {
+		if (texture != nullptr)
+			heldTextures.emplace_back(std::move(texture));
+	}
+
+	void RenderQueue::flush(SDL_Renderer *ren) {
+		if (vertices.empty())
+			return;
+
+		// untextured quads use the renderer's blend mode, restore it afterwards
+		SDL_BlendMode drawBlendMode = SDL_BLENDMODE_NONE;
+		if (batchTexture == nullptr) {
+			SDL_GetRenderDrawBlendMode(ren, &drawBlendMode);
+			SDL_SetRenderDrawBlendMode(ren, batchBlendMode);
+		}
+
+		if (SDL_RenderGeometry(ren, batchTexture, vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size())) != 0)
+			std::cout << "Failed to draw batch: " << SDL_GetError() << '\n';
+		++drawCalls;
+
+		if (batchTexture == nullptr)
+			SDL_SetRenderDrawBlendMode(ren, drawBlendMode);
+
+		vertices.clear();
+		indices.clear();
+	}
+
+	void RenderQueue::present(SDL_Renderer *ren) {
+		flush(ren);
+		SDL_RenderPresent(ren);
+		heldTextures.clear();
+
+		lastDrawCalls = drawCalls;
+		drawCalls = 0;
+	}
+
+	int RenderQueue::getDrawCallCount() const noexcept {
+		return lastDrawCalls;
+	}
+} // namespace Application::Helper
\ No newline at end of file
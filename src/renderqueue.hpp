@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/** Structure
+ *
+ * RenderQueue -> sits between Image/Text/UInterface/Animation and SDL, quads are collected instead of drawn
+ * Batch -> consecutive quads that share a texture & blend mode, submitted as one SDL_RenderGeometry call
+ *
+ *	copy(icon) copy(icon) fill fill copy(glyphs) copy(glyphs) ...
+ *	[  batch 0 (page)  ] [ batch 1 ] [   batch 2 (glyph page)  ]
+ *
+ *  submission order is kept, a batch is flushed as soon as the state changes
+ *  anything that draws around the queue (clear, render target, present) has to flush it first
+ *  batches only point at their textures, a texture nothing else owns (a cache entry that can be evicted) is held until present
+ */
+
+namespace Application::Helper {
+	class RenderQueue final {
+	public:
+		/** Queue a textured quad, the texture's colour & alpha mod are baked into the vertices.
+		 *
+		 * \param ren -> the renderer to use
+		 * \param texture -> the texture to draw
+		 * \param src -> the portion of the texture to draw (nullptr for the whole texture)
+		 * \param dst -> where to draw it
+		 */
+		void copy(SDL_Renderer *ren, SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect &dst);
+		/** Queue a filled rectangle (blended with the renderer's draw blend mode).
+		 *
+		 * \param ren -> the renderer to use
+		 * \param rect -> the rectangle to fill
+		 * \param col -> the colour of the rectangle
+		 */
+		void fillRect(SDL_Renderer *ren, const SDL_Rect &rect, SDL_Color col);
+		/** Queue a one pixel outline of a rectangle.
+		 *
+		 * \param ren -> the renderer to use
+		 * \param rect -> the rectangle to outline
+		 * \param col -> the colour of the outline
+		 */
+		void drawRect(SDL_Renderer *ren, const SDL_Rect &rect, SDL_Color col);
+		/** Keep a texture alive until the frame is presented.
+		 *
+		 * \param texture -> a texture queued this frame that could be released before the queue is flushed
+		 */
+		void hold(std::shared_ptr<SDL_Texture> texture);
+		/** Submit the pending batch.
+		 *
+		 * \param ren -> the renderer to use
+		 */
+		void flush(SDL_Renderer *ren);
+		/** Submit the pending batch & present the frame.
+		 *
+		 * \param ren -> the renderer to use
+		 */
+		void present(SDL_Renderer *ren);
+		/** Gets the number of SDL_RenderGeometry calls of the last presented frame.
+		 */
+		int getDrawCallCount() const noexcept;
+
+	private:
+		void beginBatch(SDL_Renderer *ren, SDL_Texture *texture, SDL_BlendMode blendMode);
+		void pushQuad(const SDL_FRect &dst, const SDL_FRect &uv, SDL_Color col);
+
+	private:
+		SDL_Texture *batchTexture {nullptr};
+		SDL_BlendMode batchBlendMode {SDL_BLENDMODE_NONE};
+		// size of batchTexture, used to turn clips into texture coordinates
+		int textureWidth {1};
+		int textureHeight {1};
+		std::vector<SDL_Vertex> vertices {};
+		std::vector<int> indices {};
+		// released after present
+		std::vector<std::shared_ptr<SDL_Texture>> heldTextures {};
+		int drawCalls {0};
+		int lastDrawCalls {0};
+	};
+} // namespace Application::Helper
\ No newline at end of file
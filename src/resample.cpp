@@ -0,0 +1,474 @@
+#include "resample.hpp"
+#include "memstats.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <numbers>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RESAMPLE_X86
+#include <immintrin.h>
+// MSVC compiles any intrinsic, the others only inside functions built for the instruction set
+#if defined(_MSC_VER) && !defined(__clang__)
+#define RESAMPLE_AVX2
+#else
+#define RESAMPLE_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Application::Helper {
+	// weights are fixed point, a whole pixel is 1 << weightBits
+	static constexpr int weightBits {14};
+	static constexpr int32_t rounding {1 << (weightBits - 1)};
+
+	// the source pixels every destination pixel reads along one axis
+	struct Contributions final {
+		// the first source pixel of each destination pixel
+		std::vector<int> starts {};
+		// taps weights per destination pixel (zero past the ones it uses)
+		std::vector<int16_t> weights {};
+		int taps {0};
+	};
+
+	static double getSupport(ResampleFilter filter) noexcept {
+		switch (filter) {
+			case ResampleFilter::Box: return 0.5;
+			case ResampleFilter::Bilinear: return 1.0;
+			case ResampleFilter::Lanczos: return 3.0;
+		}
+
+		return 1.0;
+	}
+
+	static double weigh(ResampleFilter filter, double x) noexcept {
+		switch (filter) {
+			case ResampleFilter::Box:
+				return x >= -0.5 && x < 0.5 ? 1.0 : 0.0;
+
+			case ResampleFilter::Bilinear:
+				return std::max(0.0, 1.0 - std::abs(x));
+
+			case ResampleFilter::Lanczos: {
+				x = std::abs(x);
+				if (x < 1e-8)
+					return 1.0;
+				if (x >= 3.0)
+					return 0.0;
+
+				const double px = std::numbers::pi * x;
+				return 3.0 * std::sin(px) * std::sin(px / 3.0) / (px * px);
+			}
+		}
+
+		return 0.0;
+	}
+
+	static Contributions getContributions(int srcSize, int dstSize, ResampleFilter filter) {
+		const double scale = static_cast<double>(srcSize) / dstSize;
+		// scaling down widens the kernel, so every source pixel is weighted in
+		const double filterScale = std::max(1.0, scale);
+		const double support = getSupport(filter) * filterScale;
+
+		Contributions result {};
+		result.taps = std::min(srcSize, static_cast<int>(std::ceil(support * 2.0)) + 2);
+		result.starts.resize(dstSize);
+		result.weights.assign(static_cast<size_t>(dstSize) * result.taps, 0);
+
+		std::vector<double> weights(result.taps);
+		for (int i = 0; i < dstSize; ++i) {
+			// pixel centres sit at +0.5, fractional scales land between them
+			const double center = (i + 0.5) * scale;
+			const int first = std::max(0, static_cast<int>(std::floor(center - support)));
+			const int last = std::min(srcSize, static_cast<int>(std::ceil(center + support)));
+
+			// every destination pixel reads the same number of taps, the window is moved back at the right edge
+			const int start = std::min(first, srcSize - result.taps);
+			result.starts[i] = start;
+
+			double total = 0.0;
+			std::fill(weights.begin(), weights.end(), 0.0);
+			for (int j = first; j < last; ++j) {
+				weights[j - start] = weigh(filter, (j + 0.5 - center) / filterScale);
+				total += weights[j - start];
+			}
+
+			// can't happen with these kernels, fall back to the nearest pixel
+			if (total <= 0.0) {
+				std::fill(weights.begin(), weights.end(), 0.0);
+				weights[std::clamp(static_cast<int>(center), start, start + result.taps - 1) - start] = 1.0;
+				total = 1.0;
+			}
+
+			// rounding can miss a whole pixel by a few units, the largest weight takes the difference
+			int16_t *fixed = &result.weights[static_cast<size_t>(i) * result.taps];
+			int sum = 0;
+			int largest = 0;
+			for (int k = 0; k < result.taps; ++k) {
+				fixed[k] = static_cast<int16_t>(std::lround(weights[k] / total * (1 << weightBits)));
+				sum += fixed[k];
+				if (fixed[k] > fixed[largest])
+					largest = k;
+			}
+			fixed[largest] = static_cast<int16_t>(fixed[largest] + (1 << weightBits) - sum);
+		}
+
+		return result;
+	}
+
+	static uint8_t toChannel(int32_t sum) noexcept {
+		return static_cast<uint8_t>(std::clamp(sum >> weightBits, 0, 255));
+	}
+
+	// colours are weighted by their alpha, otherwise the colour of transparent pixels bleeds into the edges (Lanczos' lobes make it worse)
+	// round(c * a / 255) without a division, opaque pixels come back unchanged
+	static uint32_t premultiplyChannel(uint32_t channel, uint32_t alpha) noexcept {
+		const uint32_t product = channel * alpha + 128;
+		return (product + (product >> 8)) >> 8;
+	}
+
+	static void premultiplyScalar(uint32_t *pixels, int count) {
+		for (int i = 0; i < count; ++i) {
+			const uint32_t pixel = pixels[i];
+			const uint32_t alpha = pixel >> 24;
+			pixels[i] = alpha << 24 | premultiplyChannel(pixel >> 16 & 0xFF, alpha) << 16 | premultiplyChannel(pixel >> 8 & 0xFF, alpha) << 8 | premultiplyChannel(pixel & 0xFF, alpha);
+		}
+	}
+
+	// filtering can leave a colour above its alpha, it's clamped, fully transparent pixels come out black
+	static void unpremultiplyScalar(uint32_t *pixels, int count) {
+		for (int i = 0; i < count; ++i) {
+			const uint32_t pixel = pixels[i];
+			const uint32_t alpha = pixel >> 24;
+			if (alpha == 0) {
+				pixels[i] = 0;
+				continue;
+			}
+
+			const auto channel = [alpha](uint32_t value) {return std::min<uint32_t>(255, (value * 255 + alpha / 2) / alpha);};
+			pixels[i] = alpha << 24 | channel(pixel >> 16 & 0xFF) << 16 | channel(pixel >> 8 & 0xFF) << 8 | channel(pixel & 0xFF);
+		}
+	}
+
+	// rows & pixels are 4 bytes of ARGB8888, the channels are weighted on their own so their order doesn't matter
+	static void horizontalScalar(const uint8_t *src, uint8_t *dst, int width, const Contributions &horizontal) {
+		for (int x = 0; x < width; ++x) {
+			const uint8_t *pixels = src + static_cast<size_t>(horizontal.starts[x]) * 4;
+			const int16_t *weights = &horizontal.weights[static_cast<size_t>(x) * horizontal.taps];
+
+			int32_t sums[4] {rounding, rounding, rounding, rounding};
+			for (int k = 0; k < horizontal.taps; ++k) {
+				for (int c = 0; c < 4; ++c)
+					sums[c] += pixels[k * 4 + c] * weights[k];
+			}
+
+			for (int c = 0; c < 4; ++c)
+				dst[x * 4 + c] = toChannel(sums[c]);
+		}
+	}
+
+	static void verticalScalar(const uint8_t *first, size_t stride, const int16_t *weights, int taps, uint8_t *dst, int width) {
+		for (int x = 0; x < width; ++x) {
+			int32_t sums[4] {rounding, rounding, rounding, rounding};
+			for (int k = 0; k < taps; ++k) {
+				const uint8_t *pixel = first + k * stride + static_cast<size_t>(x) * 4;
+				for (int c = 0; c < 4; ++c)
+					sums[c] += pixel[c] * weights[k];
+			}
+
+			for (int c = 0; c < 4; ++c)
+				dst[x * 4 + c] = toChannel(sums[c]);
+		}
+	}
+
+#ifdef RESAMPLE_X86
+	// two taps side by side, madd weighs both & adds them per channel
+	static int32_t packWeights(int16_t low, int16_t high) noexcept {
+		return static_cast<int32_t>(static_cast<uint32_t>(static_cast<uint16_t>(low)) | static_cast<uint32_t>(static_cast<uint16_t>(high)) << 16);
+	}
+
+	static void horizontalSSE2(const uint8_t *src, uint8_t *dst, int width, const Contributions &horizontal) {
+		const __m128i zero = _mm_setzero_si128();
+
+		for (int x = 0; x < width; ++x) {
+			const uint8_t *pixels = src + static_cast<size_t>(horizontal.starts[x]) * 4;
+			const int16_t *weights = &horizontal.weights[static_cast<size_t>(x) * horizontal.taps];
+
+			__m128i sum = _mm_set1_epi32(rounding);
+			int k = 0;
+			for (; k + 1 < horizontal.taps; k += 2) {
+				// pixels a & b -> a0 b0 a1 b1 a2 b2 a3 b3 as 16 bit
+				const __m128i pair = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pixels + k * 4));
+				const __m128i channels = _mm_unpacklo_epi8(_mm_unpacklo_epi8(pair, _mm_srli_si128(pair, 4)), zero);
+				sum = _mm_add_epi32(sum, _mm_madd_epi16(channels, _mm_set1_epi32(packWeights(weights[k], weights[k + 1]))));
+			}
+			if (k < horizontal.taps) {
+				int32_t last = 0;
+				std::memcpy(&last, pixels + k * 4, sizeof(last));
+				const __m128i channels = _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(last), zero), zero);
+				sum = _mm_add_epi32(sum, _mm_madd_epi16(channels, _mm_set1_epi32(packWeights(weights[k], 0))));
+			}
+
+			sum = _mm_srai_epi32(sum, weightBits);
+			const int32_t pixel = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(sum, sum), zero));
+			std::memcpy(dst + static_cast<size_t>(x) * 4, &pixel, sizeof(pixel));
+		}
+	}
+
+	// 4 pixels per step as 16 bit channels, the alpha is put back untouched
+	static void premultiplySSE2(uint32_t *pixels, int count) {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i half = _mm_set1_epi16(128);
+		const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+		int i = 0;
+		for (; i + 4 <= count; i += 4) {
+			const __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+			const auto scale = [&](__m128i channels) {
+				const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(channels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+				const __m128i product = _mm_add_epi16(_mm_mullo_epi16(channels, alpha), half);
+				return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+			};
+
+			const __m128i scaled = _mm_packus_epi16(scale(_mm_unpacklo_epi8(pixel, zero)), scale(_mm_unpackhi_epi8(pixel, zero)));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(pixels + i), _mm_or_si128(_mm_andnot_si128(alphaMask, scaled), _mm_and_si128(pixel, alphaMask)));
+		}
+
+		premultiplyScalar(pixels + i, count - i);
+	}
+
+	// 4 pixels per step, one channel of each at a time, the division is exact in float for these ranges so it matches the scalar kernel
+	static void unpremultiplySSE2(uint32_t *pixels, int count) {
+		const __m128i channelMask = _mm_set1_epi32(0xFF);
+		const __m128 maxChannel = _mm_set1_ps(255.0f);
+
+		int i = 0;
+		for (; i + 4 <= count; i += 4) {
+			const __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+			const __m128i alpha = _mm_srli_epi32(pixel, 24);
+			const __m128 divisor = _mm_cvtepi32_ps(alpha);
+			const __m128i halfAlpha = _mm_srli_epi32(alpha, 1);
+
+			__m128i result = _mm_slli_epi32(alpha, 24);
+			for (int shift = 0; shift < 24; shift += 8) {
+				const __m128i value = _mm_and_si128(_mm_srli_epi32(pixel, shift), channelMask);
+				const __m128i numerator = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(value, 8), value), halfAlpha);
+				// a zero alpha divides into inf/nan, min picks 255 & the pixel is masked to 0 below
+				const __m128 quotient = _mm_min_ps(_mm_div_ps(_mm_cvtepi32_ps(numerator), divisor), maxChannel);
+				result = _mm_or_si128(result, _mm_slli_epi32(_mm_cvttps_epi32(quotient), shift));
+			}
+
+			const __m128i isVisible = _mm_xor_si128(_mm_cmpeq_epi32(alpha, _mm_setzero_si128()), _mm_set1_epi32(-1));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(pixels + i), _mm_and_si128(result, isVisible));
+		}
+
+		unpremultiplyScalar(pixels + i, count - i);
+	}
+
+	// 4 pixels per step, the rest is left to the scalar kernel
+	static void verticalSSE2(const uint8_t *first, size_t stride, const int16_t *weights, int taps, uint8_t *dst, int width) {
+		const __m128i zero = _mm_setzero_si128();
+
+		int x = 0;
+		for (; x + 4 <= width; x += 4) {
+			__m128i sums[4] {_mm_set1_epi32(rounding), _mm_set1_epi32(rounding), _mm_set1_epi32(rounding), _mm_set1_epi32(rounding)};
+
+			for (int k = 0; k < taps; k += 2) {
+				const bool hasPair = k + 1 < taps;
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + k * stride + static_cast<size_t>(x) * 4));
+				const __m128i b = hasPair ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + (k + 1) * stride + static_cast<size_t>(x) * 4)) : zero;
+				const __m128i weight = _mm_set1_epi32(packWeights(weights[k], hasPair ? weights[k + 1] : 0));
+
+				// rows a & b interleaved, then widened one pixel at a time
+				const __m128i low = _mm_unpacklo_epi8(a, b);
+				const __m128i high = _mm_unpackhi_epi8(a, b);
+				sums[0] = _mm_add_epi32(sums[0], _mm_madd_epi16(_mm_unpacklo_epi8(low, zero), weight));
+				sums[1] = _mm_add_epi32(sums[1], _mm_madd_epi16(_mm_unpackhi_epi8(low, zero), weight));
+				sums[2] = _mm_add_epi32(sums[2], _mm_madd_epi16(_mm_unpacklo_epi8(high, zero), weight));
+				sums[3] = _mm_add_epi32(sums[3], _mm_madd_epi16(_mm_unpackhi_epi8(high, zero), weight));
+			}
+
+			const __m128i low = _mm_packs_epi32(_mm_srai_epi32(sums[0], weightBits), _mm_srai_epi32(sums[1], weightBits));
+			const __m128i high = _mm_packs_epi32(_mm_srai_epi32(sums[2], weightBits), _mm_srai_epi32(sums[3], weightBits));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + static_cast<size_t>(x) * 4), _mm_packus_epi16(low, high));
+		}
+
+		verticalScalar(first + static_cast<size_t>(x) * 4, stride, weights, taps, dst + static_cast<size_t>(x) * 4, width - x);
+	}
+
+	// same as SSE2 with 8 pixels per step, unpacks & packs stay inside each 128 bit lane so the order comes back out
+	RESAMPLE_AVX2 static void verticalAVX2(const uint8_t *first, size_t stride, const int16_t *weights, int taps, uint8_t *dst, int width) {
+		const __m256i zero = _mm256_setzero_si256();
+
+		int x = 0;
+		for (; x + 8 <= width; x += 8) {
+			__m256i sums[4] {_mm256_set1_epi32(rounding), _mm256_set1_epi32(rounding), _mm256_set1_epi32(rounding), _mm256_set1_epi32(rounding)};
+
+			for (int k = 0; k < taps; k += 2) {
+				const bool hasPair = k + 1 < taps;
+				const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + k * stride + static_cast<size_t>(x) * 4));
+				const __m256i b = hasPair ? _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + (k + 1) * stride + static_cast<size_t>(x) * 4)) : zero;
+				const __m256i weight = _mm256_set1_epi32(packWeights(weights[k], hasPair ? weights[k + 1] : 0));
+
+				const __m256i low = _mm256_unpacklo_epi8(a, b);
+				const __m256i high = _mm256_unpackhi_epi8(a, b);
+				sums[0] = _mm256_add_epi32(sums[0], _mm256_madd_epi16(_mm256_unpacklo_epi8(low, zero), weight));
+				sums[1] = _mm256_add_epi32(sums[1], _mm256_madd_epi16(_mm256_unpackhi_epi8(low, zero), weight));
+				sums[2] = _mm256_add_epi32(sums[2], _mm256_madd_epi16(_mm256_unpacklo_epi8(high, zero), weight));
+				sums[3] = _mm256_add_epi32(sums[3], _mm256_madd_epi16(_mm256_unpackhi_epi8(high, zero), weight));
+			}
+
+			const __m256i low = _mm256_packs_epi32(_mm256_srai_epi32(sums[0], weightBits), _mm256_srai_epi32(sums[1], weightBits));
+			const __m256i high = _mm256_packs_epi32(_mm256_srai_epi32(sums[2], weightBits), _mm256_srai_epi32(sums[3], weightBits));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + static_cast<size_t>(x) * 4), _mm256_packus_epi16(low, high));
+		}
+
+		verticalSSE2(first + static_cast<size_t>(x) * 4, stride, weights, taps, dst + static_cast<size_t>(x) * 4, width - x);
+	}
+#endif
+
+	struct Kernels final {
+		std::string_view name {};
+		void (*horizontal)(const uint8_t *, uint8_t *, int, const Contributions &) {nullptr};
+		void (*vertical)(const uint8_t *, size_t, const int16_t *, int, uint8_t *, int) {nullptr};
+		void (*premultiply)(uint32_t *, int) {nullptr};
+		void (*unpremultiply)(uint32_t *, int) {nullptr};
+	};
+
+	// the horizontal pass gathers a different window for every pixel, it stays on SSE2 (AVX2 only pays off vertically),
+	// so do the alpha passes (once per pixel, they're not worth a wider kernel)
+	static const Kernels &getKernels() {
+		static const Kernels kernels = []() -> Kernels {
+#ifdef RESAMPLE_X86
+			if (SDL_HasAVX2())
+				return {"avx2", horizontalSSE2, verticalAVX2, premultiplySSE2, unpremultiplySSE2};
+			if (SDL_HasSSE2())
+				return {"sse2", horizontalSSE2, verticalSSE2, premultiplySSE2, unpremultiplySSE2};
+#endif
+			return {"scalar", horizontalScalar, verticalScalar, premultiplyScalar, unpremultiplyScalar};
+		}();
+
+		return kernels;
+	}
+
+	std::string_view getResampleKernels() noexcept {
+		return getKernels().name;
+	}
+
+	// which byte of a pixel holds a channel, from its shift in the pixel value
+	static int getByteIndex(uint8_t shift, int bytesPerPixel) {
+		return SDL_BYTEORDER == SDL_LIL_ENDIAN ? shift / 8 : bytesPerPixel - 1 - shift / 8;
+	}
+
+	SDL_Surface *resample(SDL_Surface *src, const SDL_Rect *clip, int width, int height, ResampleFilter filter) {
+		MemoryScope scope {MemoryTag::Image};
+		PROFILE_ZONE("resample");
+
+		if (src == nullptr || width <= 0 || height <= 0)
+			return nullptr;
+
+		SDL_Rect area {0, 0, src->w, src->h};
+		if (clip != nullptr) {
+			const SDL_Rect bounds = area;
+			if (!SDL_IntersectRect(clip, &bounds, &area))
+				return nullptr;
+		}
+
+		// anything but 24 & 32 bit pixels (palettes, 16 bit) is converted first
+		SDL_Surface *source = src;
+		const int bytesPerPixel = src->format->BytesPerPixel;
+		if ((bytesPerPixel != 3 && bytesPerPixel != 4) || src->format->palette != nullptr) {
+			source = trackSurface(SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888, 0), MemoryTag::Image);
+			if (source == nullptr) {
+				std::cout << "Failed to convert surface: " << SDL_GetError() << '\n';
+				return nullptr;
+			}
+		}
+
+		SDL_Surface *dst = trackSurface(SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888), MemoryTag::Image);
+		if (dst == nullptr) {
+			std::cout << "Failed to create surface: " << SDL_GetError() << '\n';
+			if (source != src)
+				freeSurface(source);
+			return nullptr;
+		}
+
+		const SDL_PixelFormat *format = source->format;
+		const int bpp = format->BytesPerPixel;
+		const int r = getByteIndex(format->Rshift, bpp);
+		const int g = getByteIndex(format->Gshift, bpp);
+		const int b = getByteIndex(format->Bshift, bpp);
+		const int a = format->Amask != 0 ? getByteIndex(format->Ashift, bpp) : -1;
+		// ARGB8888 rows are copied as they are, the others are shuffled into ARGB one row at a time
+		const bool isARGB = format->format == SDL_PIXELFORMAT_ARGB8888;
+		// without an alpha channel every pixel is opaque, premultiplying would change nothing
+		const bool hasAlpha = a >= 0;
+
+		const Kernels &kernels = getKernels();
+		const Contributions horizontal = getContributions(area.w, width, filter);
+		const Contributions vertical = getContributions(area.h, height, filter);
+
+		// only the rows the vertical pass reads are scaled horizontally
+		const int firstRow = vertical.starts.front();
+		const int lastRow = vertical.starts.back() + vertical.taps;
+		const size_t stride = static_cast<size_t>(width) * 4;
+		std::vector<uint8_t> middle(stride * (lastRow - firstRow));
+		std::vector<uint32_t> row(isARGB && !hasAlpha ? 0 : area.w);
+
+		SDL_LockSurface(source);
+		SDL_LockSurface(dst);
+
+		for (int y = firstRow; y < lastRow; ++y) {
+			const uint8_t *pixels = static_cast<const uint8_t *>(source->pixels) + static_cast<size_t>(area.y + y) * source->pitch + static_cast<size_t>(area.x) * bpp;
+			if (!isARGB) {
+				for (int x = 0; x < area.w; ++x) {
+					const uint8_t *pixel = pixels + static_cast<size_t>(x) * bpp;
+					row[x] = static_cast<uint32_t>(hasAlpha ? pixel[a] : 255) << 24 | pixel[r] << 16 | pixel[g] << 8 | pixel[b];
+				}
+			} else if (hasAlpha) {
+				std::memcpy(row.data(), pixels, static_cast<size_t>(area.w) * sizeof(uint32_t));
+			}
+
+			if (hasAlpha)
+				kernels.premultiply(row.data(), area.w);
+			if (!row.empty())
+				pixels = reinterpret_cast<const uint8_t *>(row.data());
+
+			kernels.horizontal(pixels, &middle[(y - firstRow) * stride], width, horizontal);
+		}
+
+		for (int y = 0; y < height; ++y) {
+			uint8_t *out = static_cast<uint8_t *>(dst->pixels) + static_cast<size_t>(y) * dst->pitch;
+			kernels.vertical(&middle[(vertical.starts[y] - firstRow) * stride], stride, &vertical.weights[static_cast<size_t>(y) * vertical.taps], vertical.taps, out, width);
+			if (hasAlpha)
+				kernels.unpremultiply(reinterpret_cast<uint32_t *>(out), width);
+		}
+
+		SDL_UnlockSurface(dst);
+		SDL_UnlockSurface(source);
+
+		if (source != src)
+			freeSurface(source);
+
+		return dst;
+	}
+
+	SDL_Surface *resampleCover(SDL_Surface *src, int width, int height, ResampleFilter filter) {
+		if (src == nullptr || width <= 0 || height <= 0)
+			return nullptr;
+
+		// the part of the source that ends up on screen, at the largest scale that still covers the size
+		const double scale = std::max(static_cast<double>(width) / src->w, static_cast<double>(height) / src->h);
+		if (scale >= 1.0)
+			return nullptr;
+
+		const int cropW = std::clamp(static_cast<int>(width / scale), width, src->w);
+		const int cropH = std::clamp(static_cast<int>(height / scale), height, src->h);
+		const SDL_Rect crop {(src->w - cropW) / 2, (src->h - cropH) / 2, cropW, cropH};
+
+		return resample(src, &crop, width, height, filter);
+	}
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <string_view>
+
+/** Structure
+ *
+ * ResampleFilter -> the kernel every destination pixel is weighted with (box, triangle or Lanczos 3)
+ * resample -> scales (part of) a surface to any size, fractional factors included
+ * resampleCover -> scales a surface down until it covers a size, the overflow is cropped around the centre
+ *
+ *	source  [ clip ]  -> horizontal pass -> [ width x clip height ] -> vertical pass -> [ width x height ]
+ *
+ *  weights are computed once per pass in 14 bit fixed point, the kernel widens when scaling down so every source pixel counts
+ *  both passes run on AVX2, SSE2 or plain C++, picked once from the CPU
+ *  24 & 32 bit surfaces are read a row at a time, so a decoded photo is never converted at full size
+ *  colours are premultiplied by their alpha for both passes & divided back after, transparent pixels don't bleed into edges
+ */
+
+namespace Application::Helper {
+	enum class ResampleFilter : uint8_t {
+		Box,
+		Bilinear,
+		Lanczos
+	};
+
+	/** Scale a surface (or part of it) to a size.
+	 *
+	 * \param src -> the surface to scale (left untouched, the caller still frees it)
+	 * \param clip -> the part of the surface to scale (nullptr for all of it)
+	 * \param width -> the width of the result
+	 * \param height -> the height of the result
+	 * \param filter -> the kernel to weight the source pixels with
+	 * \return a tracked ARGB8888 surface of exactly width x height or nullptr if it failed.
+	 */
+	SDL_Surface *resample(SDL_Surface *src, const SDL_Rect *clip, int width, int height, ResampleFilter filter = ResampleFilter::Lanczos);
+	/** Scale a surface down to cover a size (aspect ratio kept).
+	 *
+	 * \param src -> the surface to scale (left untouched, the caller still frees it)
+	 * \param width -> the width to cover
+	 * \param height -> the height to cover
+	 * \param filter -> the kernel to weight the source pixels with
+	 * \return a tracked ARGB8888 surface of exactly width x height, or nullptr if src doesn't cover it (nothing to scale down) or it failed.
+	 */
+	SDL_Surface *resampleCover(SDL_Surface *src, int width, int height, ResampleFilter filter = ResampleFilter::Lanczos);
+	// the kernels resample runs on ("avx2", "sse2" or "scalar")
+	std::string_view getResampleKernels() noexcept;
+} // namespace Application::Helper
\ No newline at end of file
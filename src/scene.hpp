@@ -1,22 +1,68 @@
 #pragma once
 
 #include <SDL.h>
+#include <array>
+#include <functional>
 #include <string>
-#include <vector>
+
+/** Structure
+ *
+ * SceneID -> every scene the app has, known at compile time (no names are compared at runtime)
+ * SceneHooks -> what a scene does when it's entered, updated, drawn & left
+ * Scene -> owns the hooks of every scene, only the hooks of the shown scene are called
+ */
 
 namespace Application::Helper {
-	class Scene {
-	public:
-		~Scene() { sceneList.clear(); }
+	enum class SceneID : uint8_t {
+		Main,
+		Settings,
+		SettingsThemes,
+		ThemesBackgroundColor,
+		Count
+	};
+
+	constexpr std::string_view getSceneName(SceneID id) noexcept {
+		switch (id) {
+			case SceneID::Main: return "Main";
+			case SceneID::Settings: return "Settings";
+			case SceneID::SettingsThemes: return "Settings-Themes";
+			case SceneID::ThemesBackgroundColor: return "Themes-Background-Color";
+			default: return "Unknown";
+		}
+	}
 
-		void createScene(std::string_view name);
-		void setScene(std::string_view name);
-		constexpr uint64_t getCurrentScene();
-		constexpr uint64_t findScene(std::string_view name);
+	// any hook can be left empty
+	struct SceneHooks final {
+		std::function<void()> enter {};
+		std::function<void(double dt)> update {};
+		std::function<void()> draw {};
+		std::function<void()> exit {};
+	};
+
+	class Scene final {
+	public:
+		/** Register the hooks of a scene, replaces the ones it had.
+		 *
+		 * \param id -> the scene
+		 * \param hooks -> the callbacks of the scene
+		 */
+		void createScene(SceneID id, SceneHooks hooks);
+		/** Show another scene, the shown scene exits before the new one enters.
+		 *
+		 * \param id -> the scene to show
+		 */
+		void setScene(SceneID id);
+		SceneID getCurrentScene() const noexcept;
+		// runs the update hook of the shown scene
+		void update(double dt);
+		// runs the draw hook of the shown scene
+		void draw();
 
 	private:
-		uint64_t currentScene;
-		std::vector<std::basic_string<char>> sceneList;
+		std::array<SceneHooks, static_cast<size_t>(SceneID::Count)> scenes {};
+		SceneID currentScene {SceneID::Main};
+		// setScene wasn't called yet, there's nothing to exit
+		bool hasScene {false};
 	};
 } // namespace Application::Helper
 
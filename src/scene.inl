@@ -1,26 +1,43 @@
 #include <iostream>
 
 namespace Application::Helper {
-	inline void Scene::createScene(std::string_view name) {
-		sceneList.emplace_back(name);
+	inline void Scene::createScene(SceneID id, SceneHooks hooks) {
+		SDL_assert(id < SceneID::Count);
+		scenes[static_cast<size_t>(id)] = std::move(hooks);
 	}
 
-	inline void Scene::setScene(std::string_view name) {
-		const auto it = std::find(sceneList.begin(), sceneList.end(), name);
-		const auto sceneIndex = it - sceneList.begin();
-		currentScene = sceneIndex;
+	inline void Scene::setScene(SceneID id) {
+		SDL_assert(id < SceneID::Count);
+		if (hasScene && id == currentScene)
+			return;
 
-		std::cout << "Current Scene: " << currentScene << ", " << name << '\n';
+		if (hasScene && scenes[static_cast<size_t>(currentScene)].exit)
+			scenes[static_cast<size_t>(currentScene)].exit();
+
+		currentScene = id;
+		hasScene = true;
+
+#ifdef _DEBUG
+		std::cout << "Current Scene: " << static_cast<int>(currentScene) << ", " << getSceneName(currentScene) << '\n';
+#endif
+
+		if (scenes[static_cast<size_t>(currentScene)].enter)
+			scenes[static_cast<size_t>(currentScene)].enter();
 	}
 
-	inline constexpr uint64_t Scene::getCurrentScene() {
+	inline SceneID Scene::getCurrentScene() const noexcept {
 		return currentScene;
 	}
 
-	inline constexpr uint64_t Scene::findScene(std::string_view name) {
-		const auto it = std::find(sceneList.begin(), sceneList.end(), name);
-		const auto sceneIndex = it - sceneList.begin();
+	inline void Scene::update(double dt) {
+		const auto &hooks = scenes[static_cast<size_t>(currentScene)];
+		if (hasScene && hooks.update)
+			hooks.update(dt);
+	}
 
-		return sceneIndex;
+	inline void Scene::draw() {
+		const auto &hooks = scenes[static_cast<size_t>(currentScene)];
+		if (hasScene && hooks.draw)
+			hooks.draw();
 	}
 } // namespace Application::Helper
\ No newline at end of file
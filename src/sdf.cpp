@@ -0,0 +1,212 @@
+#include "sdf.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DISTANCE_FIELD_X86
+#include <emmintrin.h>
+#endif
+
+namespace Application::Helper {
+	// squared distances start out "unreachable", large enough to lose every comparison but still finite
+	static constexpr float unreachable {1e20f};
+
+	// squared distance to the nearest seed along one line (Felzenszwalb & Huttenlocher), in place
+	static void transformLine(float *grid, size_t offset, size_t step, int length, std::vector<float> &f, std::vector<int> &v, std::vector<float> &z) {
+		v[0] = 0;
+		z[0] = -std::numeric_limits<float>::infinity();
+		z[1] = std::numeric_limits<float>::infinity();
+		f[0] = grid[offset];
+
+		for (int q = 1, k = 0; q < length; ++q) {
+			f[q] = grid[offset + q * step];
+
+			// drop the parabolas the new one hides
+			float s = 0.0f;
+			do {
+				const int r = v[k];
+				s = (f[q] - f[r] + static_cast<float>(q * q - r * r)) / static_cast<float>(2 * (q - r));
+			} while (s <= z[k] && --k > -1);
+
+			++k;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = std::numeric_limits<float>::infinity();
+		}
+
+		for (int q = 0, k = 0; q < length; ++q) {
+			while (z[k + 1] < static_cast<float>(q))
+				++k;
+
+			const int r = v[k];
+			grid[offset + q * step] = f[r] + static_cast<float>((q - r) * (q - r));
+		}
+	}
+
+	static void transform(std::vector<float> &grid, int width, int height) {
+		const int length = std::max(width, height);
+		std::vector<float> f(length);
+		std::vector<int> v(length);
+		std::vector<float> z(length + 1);
+
+		for (int x = 0; x < width; ++x)
+			transformLine(grid.data(), x, width, height, f, v, z);
+		for (int y = 0; y < height; ++y)
+			transformLine(grid.data(), static_cast<size_t>(y) * width, 1, width, f, v, z);
+	}
+
+	void createDistanceField(const uint8_t *coverage, int width, int height, int stride, int pitch, uint8_t *field) {
+		const int fieldW = width + distanceFieldRadius * 2;
+		const int fieldH = height + distanceFieldRadius * 2;
+		const size_t size = static_cast<size_t>(fieldW) * fieldH;
+
+		// distances to the nearest pixel outside & inside, partly covered pixels seed both by how far their edge is
+		std::vector<float> outer(size, unreachable);
+		std::vector<float> inner(size, 0.0f);
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				const float alpha = coverage[static_cast<size_t>(y) * pitch + static_cast<size_t>(x) * stride] / 255.0f;
+				const size_t i = static_cast<size_t>(y + distanceFieldRadius) * fieldW + x + distanceFieldRadius;
+
+				if (alpha >= 1.0f) {
+					outer[i] = 0.0f;
+					inner[i] = unreachable;
+				} else if (alpha > 0.0f) {
+					const float edge = 0.5f - alpha;
+					outer[i] = edge > 0.0f ? edge * edge : 0.0f;
+					inner[i] = edge < 0.0f ? edge * edge : 0.0f;
+				}
+			}
+		}
+
+		transform(outer, fieldW, fieldH);
+		transform(inner, fieldW, fieldH);
+
+		for (size_t i = 0; i < size; ++i) {
+			const float distance = std::sqrt(outer[i]) - std::sqrt(inner[i]);
+			const float value = 255.0f * (1.0f - distanceFieldCutoff - distance / distanceFieldRadius);
+			field[i] = static_cast<uint8_t>(std::clamp(std::lround(value), 0L, 255L));
+		}
+	}
+
+	// the distance (target pixels) of a value is linear, so both coverages are a clamped value * slope + bias
+	struct ShadeTerms final {
+		float slope {0.0f};
+		float textBias {0.0f};
+		float outlineBias {0.0f};
+		float textAlpha {0.0f};
+		float outlineAlpha {0.0f};
+		float text[3] {};
+		float outline[3] {};
+	};
+
+	// SDL_ttf treats a fully transparent colour as opaque, the field path does the same
+	static float getAlpha(SDL_Color col) noexcept {
+		return (col.a == SDL_ALPHA_TRANSPARENT ? SDL_ALPHA_OPAQUE : col.a) / 255.0f;
+	}
+
+	static ShadeTerms getShadeTerms(const FieldShade &shade) noexcept {
+		// distance = scale * radius * (1 - cutoff - value / 255), coverage = 0.5 - distance over a one pixel ramp
+		const float reach = shade.scale * distanceFieldRadius;
+		const float edge = reach * (1.0f - distanceFieldCutoff);
+
+		ShadeTerms terms {};
+		terms.slope = reach / 255.0f;
+		terms.textBias = 0.5f - edge;
+		terms.outlineBias = 0.5f + shade.outlineThickness - edge;
+		terms.textAlpha = getAlpha(shade.textColor);
+		terms.outlineAlpha = shade.outlineThickness > 0.0f ? getAlpha(shade.outlineColor) : 0.0f;
+		terms.text[0] = shade.textColor.r;
+		terms.text[1] = shade.textColor.g;
+		terms.text[2] = shade.textColor.b;
+		terms.outline[0] = shade.outlineColor.r;
+		terms.outline[1] = shade.outlineColor.g;
+		terms.outline[2] = shade.outlineColor.b;
+
+		return terms;
+	}
+
+	// the text is blended over its outline, same order of operations as the SSE2 kernel so both give the same pixels
+	static void shadeScalar(const uint8_t *field, uint32_t *pixels, size_t count, const ShadeTerms &terms) {
+		for (size_t i = 0; i < count; ++i) {
+			const float value = field[i];
+			const float text = std::clamp(value * terms.slope + terms.textBias, 0.0f, 1.0f) * terms.textAlpha;
+			const float outline = std::clamp(value * terms.slope + terms.outlineBias, 0.0f, 1.0f) * terms.outlineAlpha * (1.0f - text);
+			const float alpha = text + outline;
+			const float inverse = 1.0f / std::max(alpha, 1e-6f);
+
+			const auto channel = [&](int c) {
+				return static_cast<uint32_t>(std::lrint((terms.text[c] * text + terms.outline[c] * outline) * inverse));
+			};
+			pixels[i] = static_cast<uint32_t>(std::lrint(alpha * 255.0f)) << 24 | channel(0) << 16 | channel(1) << 8 | channel(2);
+		}
+	}
+
+#ifdef DISTANCE_FIELD_X86
+	// 4 pixels per step, the rest is left to the scalar kernel
+	static void shadeSSE2(const uint8_t *field, uint32_t *pixels, size_t count, const ShadeTerms &terms) {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 none = _mm_setzero_ps();
+		const __m128 full = _mm_set1_ps(1.0f);
+		const __m128 slope = _mm_set1_ps(terms.slope);
+		const __m128 textBias = _mm_set1_ps(terms.textBias);
+		const __m128 outlineBias = _mm_set1_ps(terms.outlineBias);
+		const __m128 textAlpha = _mm_set1_ps(terms.textAlpha);
+		const __m128 outlineAlpha = _mm_set1_ps(terms.outlineAlpha);
+		const __m128 epsilon = _mm_set1_ps(1e-6f);
+		const __m128 maxChannel = _mm_set1_ps(255.0f);
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			int32_t packed = 0;
+			std::memcpy(&packed, field + i, sizeof(packed));
+			const __m128 value = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero));
+
+			const __m128 text = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(value, slope), textBias), none), full), textAlpha);
+			const __m128 outlineCoverage = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(value, slope), outlineBias), none), full);
+			const __m128 outline = _mm_mul_ps(_mm_mul_ps(outlineCoverage, outlineAlpha), _mm_sub_ps(full, text));
+			const __m128 alpha = _mm_add_ps(text, outline);
+			const __m128 inverse = _mm_div_ps(full, _mm_max_ps(alpha, epsilon));
+
+			__m128i result = _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(alpha, maxChannel)), 24);
+			for (int c = 0; c < 3; ++c) {
+				const __m128 mixed = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(terms.text[c]), text), _mm_mul_ps(_mm_set1_ps(terms.outline[c]), outline));
+				const __m128i channel = _mm_cvtps_epi32(_mm_mul_ps(mixed, inverse));
+				result = _mm_or_si128(result, c == 0 ? _mm_slli_epi32(channel, 16) : c == 1 ? _mm_slli_epi32(channel, 8) : channel);
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(pixels + i), result);
+		}
+
+		shadeScalar(field + i, pixels + i, count - i, terms);
+	}
+#endif
+
+	struct ShadeKernel final {
+		std::string_view name {};
+		void (*shade)(const uint8_t *, uint32_t *, size_t, const ShadeTerms &) {nullptr};
+	};
+
+	static const ShadeKernel &getShadeKernel() {
+		static const ShadeKernel kernel = []() -> ShadeKernel {
+#ifdef DISTANCE_FIELD_X86
+			if (SDL_HasSSE2())
+				return {"sse2", shadeSSE2};
+#endif
+			return {"scalar", shadeScalar};
+		}();
+
+		return kernel;
+	}
+
+	void shadeDistanceField(const uint8_t *field, uint32_t *pixels, size_t count, const FieldShade &shade) {
+		getShadeKernel().shade(field, pixels, count, getShadeTerms(shade));
+	}
+
+	std::string_view getDistanceFieldKernels() noexcept {
+		return getShadeKernel().name;
+	}
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <string_view>
+
+/** Structure
+ *
+ * distance field -> one byte per pixel, how far the pixel is from the edge of the glyph (inside is brighter)
+ *
+ *	0 ........ 191 ...... 255
+ *	far outside  ^ edge   deep inside          value = 255 * (1 - cutoff - distance / radius)
+ *
+ * createDistanceField -> turns a coverage bitmap into a field padded by the radius on every side
+ * shadeDistanceField -> the "pixel shader", thresholds a field scaled to any size into text & outline colours
+ *
+ *  a field made once at one size is shaded at every size, outline thickness & colour, only the threshold changes
+ *  SDL's renderer has no shaders, so shading runs on the CPU (SSE2 or plain C++, picked once from the CPU)
+ */
+
+namespace Application::Helper {
+	// how far (field pixels) the field reaches from the edge, outside & inside together
+	constexpr int distanceFieldRadius {12};
+	// the part of the radius that is inside the glyph, the rest is left for outlines
+	constexpr float distanceFieldCutoff {0.25f};
+
+	struct FieldShade final {
+		// target pixels per field pixel
+		float scale {1.0f};
+		// how far the outline reaches out of the glyph (target pixels, 0 for none)
+		float outlineThickness {0.0f};
+		SDL_Color textColor {255, 255, 255, 255};
+		SDL_Color outlineColor {0, 0, 0, 255};
+	};
+
+	/** Create the distance field of a coverage bitmap.
+	 *
+	 * \param coverage -> one byte per pixel, 255 is inside (an alpha channel)
+	 * \param width -> the width of the bitmap
+	 * \param height -> the height of the bitmap
+	 * \param stride -> the bytes between two coverage values of a row (4 to read the alpha of ARGB pixels)
+	 * \param pitch -> the bytes between two rows
+	 * \param field -> receives (width + 2 * radius) x (height + 2 * radius) values
+	 */
+	void createDistanceField(const uint8_t *coverage, int width, int height, int stride, int pitch, uint8_t *field);
+	/** Threshold distance field values into ARGB8888 pixels (not premultiplied).
+	 *
+	 * \param field -> the values, already scaled to the target size
+	 * \param pixels -> receives one pixel per value
+	 * \param count -> the number of values
+	 * \param shade -> the scale, outline & colours to shade with
+	 */
+	void shadeDistanceField(const uint8_t *field, uint32_t *pixels, size_t count, const FieldShade &shade);
+	// the kernels shadeDistanceField runs on ("sse2" or "scalar")
+	std::string_view getDistanceFieldKernels() noexcept;
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,399 @@
+#include "text.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace Application::Helper {
+	// decode one codepoint and advance the index (invalid sequences become U+FFFD)
+	static uint32_t decodeUTF8(std::string_view str, size_t &i) noexcept {
+		const auto byte = [&](size_t n) -> uint32_t {return static_cast<unsigned char>(str[n]);};
+		const uint32_t lead = byte(i);
+
+		int length = 0;
+		uint32_t codepoint = 0;
+		if (lead < 0x80) {
+			++i;
+			return lead;
+		} else if ((lead & 0xE0) == 0xC0) {
+			length = 2;
+			codepoint = lead & 0x1F;
+		} else if ((lead & 0xF0) == 0xE0) {
+			length = 3;
+			codepoint = lead & 0x0F;
+		} else if ((lead & 0xF8) == 0xF0) {
+			length = 4;
+			codepoint = lead & 0x07;
+		} else {
+			++i;
+			return 0xFFFD;
+		}
+
+		if (i + length > str.size()) {
+			i = str.size();
+			return 0xFFFD;
+		}
+
+		for (int n = 1; n < length; ++n) {
+			if ((byte(i + n) & 0xC0) != 0x80) {
+				i += n;
+				return 0xFFFD;
+			}
+			codepoint = (codepoint << 6) | (byte(i + n) & 0x3F);
+		}
+		i += length;
+
+		return codepoint;
+	}
+
+	// SDL_ttf treats a fully transparent colour as opaque, keep that behaviour for the atlas
+	static uint8_t alphaOf(SDL_Color col) noexcept {
+		return col.a == SDL_ALPHA_TRANSPARENT ? SDL_ALPHA_OPAQUE : col.a;
+	}
+
+	static bool isSameColor(SDL_Color a, SDL_Color b) noexcept {
+		return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+	}
+
+	// bilinear samples of a glyph field scaled onto the field of a run, overlapping glyphs keep whichever is more inside
+	static void splatField(const uint8_t *glyph, int glyphW, int glyphH, float left, float top, float scale, std::vector<uint8_t> &field, int width, int height) {
+		const int x0 = std::max(0, static_cast<int>(std::floor(left)));
+		const int y0 = std::max(0, static_cast<int>(std::floor(top)));
+		const int x1 = std::min(width, static_cast<int>(std::ceil(left + glyphW * scale)));
+		const int y1 = std::min(height, static_cast<int>(std::ceil(top + glyphH * scale)));
+
+		// past the padding everything is far outside
+		const auto at = [&](int x, int y) -> float {
+			return x < 0 || y < 0 || x >= glyphW || y >= glyphH ? 0.0f : glyph[static_cast<size_t>(y) * glyphW + x];
+		};
+
+		for (int y = y0; y < y1; ++y) {
+			const float fy = (y + 0.5f - top) / scale - 0.5f;
+			const int iy = static_cast<int>(std::floor(fy));
+			const float ty = fy - iy;
+
+			uint8_t *row = &field[static_cast<size_t>(y) * width];
+			for (int x = x0; x < x1; ++x) {
+				const float fx = (x + 0.5f - left) / scale - 0.5f;
+				const int ix = static_cast<int>(std::floor(fx));
+				const float tx = fx - ix;
+
+				const float upper = at(ix, iy) + (at(ix + 1, iy) - at(ix, iy)) * tx;
+				const float lower = at(ix, iy + 1) + (at(ix + 1, iy + 1) - at(ix, iy + 1)) * tx;
+				row[x] = std::max(row[x], static_cast<uint8_t>(std::lround(upper + (lower - upper) * ty)));
+			}
+		}
+	}
+
+	Text::Text(std::shared_ptr<FontCache> fonts, std::shared_ptr<RenderQueue> queue) : fontPtr(std::move(fonts)), queuePtr(std::move(queue)) {}
+
+	bool Text::reserve(SDL_Renderer *ren, int w, int h, int &page, SDL_Rect &rect) {
+		if (w + padding > pageSize || h + padding > pageSize) {
+			std::cout << "Glyph is larger than an atlas page\n";
+			return false;
+		}
+
+		// move down to a new shelf
+		if (shelfX + w + padding > pageSize) {
+			shelfX = 0;
+			shelfY += shelfHeight;
+			shelfHeight = 0;
+		}
+
+		// out of shelves, start a new page
+		if (pages.empty() || shelfY + h + padding > pageSize) {
+			auto newPage = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, pageSize, pageSize), MemoryTag::Font));
+			if (newPage == nullptr) {
+				std::cout << "Glyph atlas page failed to be created: " << SDL_GetError() << '\n';
+				return false;
+			}
+			SDL_SetTextureBlendMode(newPage.get(), SDL_BLENDMODE_BLEND);
+
+			// clear the page so the padding between glyphs stays transparent
+			std::vector<uint32_t> blank(pageSize * pageSize, 0);
+			SDL_UpdateTexture(newPage.get(), nullptr, blank.data(), pageSize * sizeof(uint32_t));
+
+			pages.emplace_back(std::move(newPage));
+			shelfX = 0;
+			shelfY = 0;
+			shelfHeight = 0;
+		}
+
+		page = static_cast<int>(pages.size()) - 1;
+		rect = {shelfX, shelfY, w, h};
+
+		shelfX += w + padding;
+		shelfHeight = std::max(shelfHeight, h + padding);
+
+		return true;
+	}
+
+	const Glyph *Text::getGlyph(TTF_Font *font, uint32_t fontId, uint32_t codepoint, SDL_Renderer *ren) {
+		const uint64_t key = (static_cast<uint64_t>(fontId) << 32) | codepoint;
+
+		auto iter = glyphs.find(key);
+		if (iter != glyphs.end())
+			return &iter->second;
+
+		Glyph newGlyph {};
+		if (TTF_GlyphMetrics32(font, codepoint, nullptr, nullptr, nullptr, nullptr, &newGlyph.advance) != 0)
+			newGlyph.advance = 0;
+
+		// glyphs are rasterized white and tinted with the texture colour mod when drawn
+		SDL_Surface *surf = trackSurface(TTF_RenderGlyph32_Blended(font, codepoint, {255, 255, 255, 255}), MemoryTag::Font);
+		if (surf == nullptr) {
+			// whitespace has nothing to rasterize, it only moves the pen
+			return &glyphs.insert({key, newGlyph}).first->second;
+		}
+
+		SDL_Surface *converted = trackSurface(SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0), MemoryTag::Font);
+		freeSurface(surf);
+		if (converted == nullptr) {
+			std::cout << "Failed to convert glyph: " << SDL_GetError() << '\n';
+			return nullptr;
+		}
+
+		if (!reserve(ren, converted->w, converted->h, newGlyph.page, newGlyph.clip)) {
+			freeSurface(converted);
+			return nullptr;
+		}
+		SDL_UpdateTexture(pages[newGlyph.page].get(), &newGlyph.clip, converted->pixels, converted->pitch);
+		freeSurface(converted);
+
+		return &glyphs.insert({key, newGlyph}).first->second;
+	}
+
+	const FieldGlyph *Text::getFieldGlyph(TTF_Font *font, uint32_t fontId, uint32_t codepoint) {
+		const uint64_t key = (static_cast<uint64_t>(fontId) << 32) | codepoint;
+
+		auto iter = fieldGlyphs.find(key);
+		if (iter != fieldGlyphs.end())
+			return &iter->second;
+
+		FieldGlyph newGlyph {};
+		if (TTF_GlyphMetrics32(font, codepoint, nullptr, nullptr, nullptr, nullptr, &newGlyph.advance) != 0)
+			newGlyph.advance = 0;
+
+		SDL_Surface *surf = trackSurface(TTF_RenderGlyph32_Blended(font, codepoint, {255, 255, 255, 255}), MemoryTag::Font);
+		if (surf == nullptr)
+			return &fieldGlyphs.insert({key, newGlyph}).first->second;
+
+		SDL_Surface *converted = trackSurface(SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0), MemoryTag::Font);
+		freeSurface(surf);
+		if (converted == nullptr) {
+			std::cout << "Failed to convert glyph: " << SDL_GetError() << '\n';
+			return nullptr;
+		}
+
+		// only the coverage (alpha) matters, the glyph is white
+		newGlyph.offset = fieldAtlas.size();
+		newGlyph.w = converted->w + distanceFieldRadius * 2;
+		newGlyph.h = converted->h + distanceFieldRadius * 2;
+		fieldAtlas.resize(newGlyph.offset + static_cast<size_t>(newGlyph.w) * newGlyph.h);
+
+		const int alphaByte = SDL_BYTEORDER == SDL_LIL_ENDIAN ? 3 : 0;
+		SDL_LockSurface(converted);
+		createDistanceField(static_cast<const uint8_t *>(converted->pixels) + alphaByte, converted->w, converted->h, 4, converted->pitch, &fieldAtlas[newGlyph.offset]);
+		SDL_UnlockSurface(converted);
+		freeSurface(converted);
+
+		return &fieldGlyphs.insert({key, newGlyph}).first->second;
+	}
+
+	bool Text::shapeQuads(const FontKey &key, std::string_view text, SDL_Renderer *ren, std::vector<GlyphQuad> &quads, int &width) {
+		uint32_t fontId = 0;
+		TTF_Font *font = fontPtr->getFont(key, &fontId);
+		if (font == nullptr)
+			return false;
+
+		quads.clear();
+		int penX = 0;
+		uint32_t previous = 0;
+		for (size_t i = 0; i < text.size();) {
+			const uint32_t codepoint = decodeUTF8(text, i);
+			if (previous != 0)
+				penX += TTF_GetFontKerningSizeGlyphs32(font, previous, codepoint);
+			previous = codepoint;
+
+			const Glyph *glyph = getGlyph(font, fontId, codepoint, ren);
+			if (glyph == nullptr)
+				return false;
+
+			if (glyph->clip.w > 0)
+				quads.push_back({glyph->page, glyph->clip, penX, 0});
+
+			penX += glyph->advance;
+		}
+		width = std::max(width, penX);
+
+		return true;
+	}
+
+	bool Text::shapeField(const MessageData &msg, SDL_Renderer *ren, TextRun &run) {
+		uint32_t fontId = 0;
+		TTF_Font *font = fontPtr->getFont({std::basic_string<char>(msg.fontFile), fieldSize, 0}, &fontId);
+		if (font == nullptr || msg.fontSize <= 0)
+			return false;
+
+		struct Placement final {
+			const FieldGlyph *glyph {nullptr};
+			int penX {0};
+		};
+
+		// laid out at the field size, the whole run is scaled at once so pen positions stay fractional
+		std::vector<Placement> placements {};
+		int penX = 0;
+		uint32_t previous = 0;
+		for (size_t i = 0; i < msg.msg.size();) {
+			const uint32_t codepoint = decodeUTF8(msg.msg, i);
+			if (previous != 0)
+				penX += TTF_GetFontKerningSizeGlyphs32(font, previous, codepoint);
+			previous = codepoint;
+
+			const FieldGlyph *glyph = getFieldGlyph(font, fontId, codepoint);
+			if (glyph == nullptr)
+				return false;
+
+			if (glyph->w > 0)
+				placements.push_back({glyph, penX});
+
+			penX += glyph->advance;
+		}
+
+		// the outline sits behind the text, so the text is shifted forward by its thickness
+		const float scale = static_cast<float>(msg.fontSize) / fieldSize;
+		const int offset = run.outlineThickness;
+		run.width = static_cast<int>(std::ceil(penX * scale)) + offset * 2;
+		run.height = static_cast<int>(std::ceil(TTF_FontHeight(font) * scale)) + offset * 2;
+		run.field.assign(static_cast<size_t>(std::max(run.width, 0)) * std::max(run.height, 0), 0);
+
+		for (const auto &placement : placements) {
+			const FieldGlyph &glyph = *placement.glyph;
+			splatField(&fieldAtlas[glyph.offset], glyph.w, glyph.h, offset + (placement.penX - distanceFieldRadius) * scale, offset - distanceFieldRadius * scale, scale, run.field, run.width, run.height);
+		}
+
+		return shadeField(run, ren);
+	}
+
+	bool Text::shadeField(TextRun &run, SDL_Renderer *ren) {
+		if (run.field.empty()) {
+			run.texture.reset();
+			return true;
+		}
+
+		FieldShade shade {};
+		shade.scale = static_cast<float>(run.fontSize) / fieldSize;
+		shade.outlineThickness = static_cast<float>(run.outlineThickness);
+		shade.textColor = run.textColor;
+		shade.outlineColor = run.outlineColor;
+
+		shaded.resize(run.field.size());
+		shadeDistanceField(run.field.data(), shaded.data(), run.field.size(), shade);
+
+		// the texture is only recreated when the run changes size
+		int w = 0;
+		int h = 0;
+		if (run.texture == nullptr || SDL_QueryTexture(run.texture.get(), nullptr, nullptr, &w, &h) != 0 || w != run.width || h != run.height) {
+			run.texture = Utilities::PTR<SDL_Texture>(trackTexture(SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, run.width, run.height), MemoryTag::Font));
+			if (run.texture == nullptr) {
+				std::cout << "Text run texture failed to be created: " << SDL_GetError() << '\n';
+				return false;
+			}
+			SDL_SetTextureBlendMode(run.texture.get(), SDL_BLENDMODE_BLEND);
+		}
+		SDL_UpdateTexture(run.texture.get(), nullptr, shaded.data(), run.width * static_cast<int>(sizeof(uint32_t)));
+
+		return true;
+	}
+
+	bool Text::shape(const MessageData &msg, SDL_Renderer *ren, TextRun &run, bool outline) {
+		MemoryScope scope {MemoryTag::Font};
+		PROFILE_ZONE("Text::shape");
+
+		const int outlineThickness = outline ? msg.outlineThickness : 0;
+		// the black outline createTextA has always had
+		const SDL_Color outlineColor {0x00, 0x00, 0x00};
+
+		const bool isRecolored = !isSameColor(run.textColor, msg.col.textColor) || !isSameColor(run.outlineColor, outlineColor);
+		run.textColor = msg.col.textColor;
+		run.outlineColor = outlineColor;
+
+		// field runs have their colours shaded in, a new colour only runs the shader again
+		if (run.text == msg.msg && run.fontFile == msg.fontFile && run.fontSize == msg.fontSize && run.outlineThickness == outlineThickness && run.isField == outline)
+			return !run.isField || !isRecolored || shadeField(run, ren);
+
+		run.text = msg.msg;
+		run.fontFile = msg.fontFile;
+		run.fontSize = msg.fontSize;
+		run.outlineThickness = outlineThickness;
+		run.isField = outline;
+		run.width = 0;
+		run.quads.clear();
+		run.field.clear();
+
+		if (outline ? !shapeField(msg, ren, run) : !shapeQuads({std::basic_string<char>(msg.fontFile), msg.fontSize, 0}, msg.msg, ren, run.quads, run.width)) {
+			// forget the inputs so the next call tries again
+			run.text.clear();
+			run.fontFile.clear();
+			run.quads.clear();
+			run.field.clear();
+			run.texture.reset();
+			return false;
+		}
+
+		if (!outline)
+			run.height = TTF_FontHeight(fontPtr->getFont({std::basic_string<char>(msg.fontFile), msg.fontSize, 0}));
+
+		return true;
+	}
+
+	void Text::drawQuads(const std::vector<GlyphQuad> &quads, SDL_Color col, SDL_Renderer *ren, int x, int y, float sx, float sy) noexcept {
+		int currentPage = -1;
+		for (const auto &quad : quads) {
+			if (quad.page != currentPage) {
+				currentPage = quad.page;
+				SDL_SetTextureColorMod(pages[currentPage].get(), col.r, col.g, col.b);
+				SDL_SetTextureAlphaMod(pages[currentPage].get(), alphaOf(col));
+			}
+
+			// round the edges instead of the sizes so neighbouring glyphs don't drift apart
+			const int left = static_cast<int>(std::lround(quad.x * sx));
+			const int top = static_cast<int>(std::lround(quad.y * sy));
+			const int right = static_cast<int>(std::lround((quad.x + quad.clip.w) * sx));
+			const int bottom = static_cast<int>(std::lround((quad.y + quad.clip.h) * sy));
+
+			SDL_Rect dst {x + left, y + top, right - left, bottom - top};
+			queuePtr->copy(ren, pages[currentPage].get(), &quad.clip, dst);
+		}
+	}
+
+	void Text::draw(const TextRun &run, SDL_Renderer *ren, int x, int y) noexcept {
+		if (run.isField) {
+			if (run.texture != nullptr)
+				queuePtr->copy(ren, run.texture.get(), nullptr, {x, y, run.width, run.height});
+			return;
+		}
+
+		drawQuads(run.quads, run.textColor, ren, x, y, 1.0f, 1.0f);
+	}
+
+	void Text::draw(const TextRun &run, SDL_Renderer *ren, const SDL_Rect &dst) noexcept {
+		if (run.width <= 0 || run.height <= 0)
+			return;
+
+		if (run.isField) {
+			if (run.texture != nullptr)
+				queuePtr->copy(ren, run.texture.get(), nullptr, dst);
+			return;
+		}
+
+		const float sx = static_cast<float>(dst.w) / static_cast<float>(run.width);
+		const float sy = static_cast<float>(dst.h) / static_cast<float>(run.height);
+
+		drawQuads(run.quads, run.textColor, ren, dst.x, dst.y, sx, sy);
+	}
+
+	void Text::printGlyphCount() const noexcept {
+		std::cout << "Glyph Count: " << glyphs.size() << ", Atlas Pages: " << pages.size() << ", Field Glyphs: " << fieldGlyphs.size() << " (" << fieldAtlas.size() / 1024 << " KB)\n";
+	}
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include "data.hpp"
+#include "font.hpp"
+#include "renderqueue.hpp"
+#include "sdf.hpp"
+#include "util.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** Structure
+ *
+ * Glyph -> a single rasterized glyph (font, size, codepoint) living on an atlas page
+ * FieldGlyph -> the distance field of a glyph (font, codepoint), made once at fieldSize for every size (see sdf.hpp)
+ * GlyphQuad -> a glyph placed on the pen line of a run
+ * TextRun -> a UTF-8 string shaped into quads, drawn straight from the atlas
+ *            outlined runs are shaded from the distance fields into one texture instead
+ * Text -> owns the atlas pages & the field atlas, rasterizes every glyph exactly once
+ *
+ *	---------------------------
+ *	| A | B | C | 0 | 1 | 2 | : |   <- shelf 0
+ *	---------------------------
+ *	| + | x | - | ...           |   <- shelf 1
+ *	---------------------------
+ *  glyphs are packed on shelves, a new page is created when a page is full
+ */
+
+namespace Application::Helper {
+	struct Glyph final {
+		int page {0};
+		SDL_Rect clip {0};
+		int advance {0};
+	};
+
+	struct FieldGlyph final {
+		// where the field starts in the field atlas
+		size_t offset {0};
+		// the field size (the glyph padded by the radius), 0 for whitespace
+		int w {0};
+		int h {0};
+		int advance {0};
+	};
+
+	struct GlyphQuad final {
+		int page {0};
+		SDL_Rect clip {0};
+		int x {0};
+		int y {0};
+	};
+
+	struct TextRun final {
+		// the inputs the quads were shaped from (reshaping is skipped while these match)
+		std::basic_string<char> text {};
+		std::basic_string<char> fontFile {};
+		int fontSize {0};
+		int outlineThickness {0};
+		SDL_Color textColor {255, 255, 255};
+		SDL_Color outlineColor {0, 0, 0};
+		// shaped from the distance field (outlined), drawn from texture instead of quads
+		bool isField {false};
+		std::vector<GlyphQuad> quads {};
+		// the field of the whole run at its size, a colour change only shades it again
+		std::vector<uint8_t> field {};
+		std::shared_ptr<SDL_Texture> texture {nullptr};
+		int width {0};
+		int height {0};
+		// size offsets used when drawn inside of a button (see UInterface::setButtonTextSize)
+		int imageWidth {0};
+		int imageHeight {0};
+	};
+
+	class Text final {
+	public:
+		/** Create the text atlas.
+		 *
+		 * \param fonts -> the font cache glyphs are rasterized from
+		 * \param queue -> the queue glyph quads are submitted to
+		 */
+		Text(std::shared_ptr<FontCache> fonts, std::shared_ptr<RenderQueue> queue);
+		Text(const Text &) = delete;
+		Text &operator=(const Text &) = delete;
+
+		/** Shape a string into a run of glyph quads, rasterizing any glyph that isn't in the atlas yet.
+		 *
+		 * \param msg -> a struct constructed with:
+		 * \param - msg -> the UTF-8 string of text
+		 * \param - fontFile -> the font file for the text
+		 * \param - col -> the colour of the text
+		 * \param - fontSize -> the size of the text
+		 * \param - outlineThickness -> the thickness of the text outline (only used when outline is true)
+		 * \param ren -> the renderer that owns the atlas pages
+		 * \param run -> the run to fill, it is left untouched when the inputs haven't changed
+		 * \param outline -> whether the run is drawn with an outline behind it (shaded from the distance field)
+		 * \return true if the run is ready to be drawn, otherwise false.
+		 */
+		bool shape(const MessageData &msg, SDL_Renderer *ren, TextRun &run, bool outline = false);
+		/** Draws a run at its natural size.
+		 *
+		 * \param run -> the shaped run to draw
+		 * \param ren -> the renderer to use
+		 * \param x -> x position of the text
+		 * \param y -> y position of the text
+		 */
+		void draw(const TextRun &run, SDL_Renderer *ren, int x, int y) noexcept;
+		/** Draws a run stretched to fit the destination.
+		 *
+		 * \param run -> the shaped run to draw
+		 * \param ren -> the renderer to use
+		 * \param dst -> the area to fit the text into
+		 */
+		void draw(const TextRun &run, SDL_Renderer *ren, const SDL_Rect &dst) noexcept;
+		/** Prints the number of glyphs & atlas pages.
+		 */
+		void printGlyphCount() const noexcept;
+
+	private:
+		const Glyph *getGlyph(TTF_Font *font, uint32_t fontId, uint32_t codepoint, SDL_Renderer *ren);
+		const FieldGlyph *getFieldGlyph(TTF_Font *font, uint32_t fontId, uint32_t codepoint);
+		bool shapeQuads(const FontKey &key, std::string_view text, SDL_Renderer *ren, std::vector<GlyphQuad> &quads, int &width);
+		bool shapeField(const MessageData &msg, SDL_Renderer *ren, TextRun &run);
+		bool shadeField(TextRun &run, SDL_Renderer *ren);
+		bool reserve(SDL_Renderer *ren, int w, int h, int &page, SDL_Rect &rect);
+		void drawQuads(const std::vector<GlyphQuad> &quads, SDL_Color col, SDL_Renderer *ren, int x, int y, float sx, float sy) noexcept;
+
+	private:
+		static constexpr int pageSize {512};
+		static constexpr int padding {1};
+		// the point size distance fields are made at, large enough to keep the corners of a 96pt clock
+		static constexpr int fieldSize {48};
+
+		std::shared_ptr<FontCache> fontPtr {nullptr};
+		std::shared_ptr<RenderQueue> queuePtr {nullptr};
+		// (font cache id << 32 | codepoint) -> glyph
+		std::unordered_map<uint64_t, Glyph> glyphs {};
+		std::vector<Utilities::PTR<SDL_Texture>> pages {};
+		// (font cache id << 32 | codepoint) -> distance field glyph, every field lives in the field atlas
+		std::unordered_map<uint64_t, FieldGlyph> fieldGlyphs {};
+		std::vector<uint8_t> fieldAtlas {};
+		// reused by every shaded run
+		std::vector<uint32_t> shaded {};
+		// shelf cursor on the last page
+		int shelfX {0};
+		int shelfY {0};
+		int shelfHeight {0};
+	};
+} // namespace Application::Helper
\ No newline at end of file
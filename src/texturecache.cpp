@@ -0,0 +1,174 @@
+#include "texturecache.hpp"
+#include "memstats.hpp"
+#include <iostream>
+
+namespace Application::Helper {
+	static constexpr uint64_t hashSeed {0xcbf29ce484222325ull};
+
+	// FNV-1a
+	static void hashBytes(uint64_t &hash, const void *data, size_t size) noexcept {
+		const auto *bytes = static_cast<const uint8_t *>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ull;
+		}
+	}
+
+	// prefixed with the length so neighbouring strings can't run into each other
+	static void hashString(uint64_t &hash, std::string_view str) noexcept {
+		const uint64_t size = str.size();
+		hashBytes(hash, &size, sizeof(size));
+		hashBytes(hash, str.data(), str.size());
+	}
+
+	static void hashColor(uint64_t &hash, SDL_Color col) noexcept {
+		const uint8_t channels[] = {col.r, col.g, col.b, col.a};
+		hashBytes(hash, channels, sizeof(channels));
+	}
+
+	static void hashInt(uint64_t &hash, int value) noexcept {
+		hashBytes(hash, &value, sizeof(value));
+	}
+
+	TextureCache::TextureCache(size_t budget) : budget(budget) {}
+
+	uint64_t TextureCache::getKey(std::string_view path, const SDL_Color *colorKey) noexcept {
+		// images & texts never share a key
+		uint64_t hash = hashSeed;
+		hashInt(hash, 'i');
+		hashString(hash, path);
+		hashInt(hash, colorKey != nullptr ? 1 : 0);
+		if (colorKey != nullptr)
+			hashColor(hash, *colorKey);
+
+		return hash;
+	}
+
+	uint64_t TextureCache::getKey(std::string_view path, int width, int height, ResampleFilter filter) noexcept {
+		uint64_t hash = hashSeed;
+		hashInt(hash, 's');
+		hashString(hash, path);
+		hashInt(hash, width);
+		hashInt(hash, height);
+		hashInt(hash, static_cast<int>(filter));
+
+		return hash;
+	}
+
+	uint64_t TextureCache::getKey(const MessageData &msg, bool hasOutline) noexcept {
+		uint64_t hash = hashSeed;
+		hashInt(hash, 't');
+		hashString(hash, msg.msg);
+		hashString(hash, msg.fontFile);
+		hashInt(hash, msg.fontSize);
+		hashColor(hash, msg.col.outlineColor);
+		hashColor(hash, msg.col.bgColor);
+		hashColor(hash, msg.col.textColor);
+		// the thickness only changes texts that have an outline
+		hashInt(hash, hasOutline ? msg.outlineThickness : -1);
+
+		return hash;
+	}
+
+	IMD TextureCache::find(uint64_t key) {
+		auto iter = entries.find(key);
+		if (iter == entries.end()) {
+			++stats.misses;
+			return nullptr;
+		}
+
+		++stats.hits;
+		recentList.splice(recentList.begin(), recentList, iter->second.recent);
+
+		return iter->second.image;
+	}
+
+	IMD TextureCache::insert(uint64_t key, IMD img) {
+		if (img == nullptr)
+			return nullptr;
+
+		auto iter = entries.find(key);
+		if (iter != entries.end()) {
+			stats.bytes -= iter->second.bytes;
+			recentList.erase(iter->second.recent);
+			entries.erase(iter);
+		}
+
+		recentList.emplace_front(key);
+		const size_t bytes = getByteSize(*img);
+		entries.insert({key, {img, bytes, recentList.begin()}});
+		stats.bytes += bytes;
+		stats.count = entries.size();
+
+		evict(budget);
+
+		return img;
+	}
+
+	bool TextureCache::remove(const IMD &img) {
+		for (auto iter = entries.begin(); iter != entries.end(); ++iter) {
+			if (iter->second.image != img)
+				continue;
+
+			stats.bytes -= iter->second.bytes;
+			recentList.erase(iter->second.recent);
+			entries.erase(iter);
+			stats.count = entries.size();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	size_t TextureCache::trim(size_t bytes) {
+		const size_t before = stats.bytes;
+		evict(bytes);
+
+		return before - stats.bytes;
+	}
+
+	void TextureCache::setBudget(size_t budget) {
+		this->budget = budget;
+		evict(budget);
+	}
+
+	size_t TextureCache::getBudget() const noexcept {
+		return budget;
+	}
+
+	const CacheStats &TextureCache::getStats() const noexcept {
+		return stats;
+	}
+
+	void TextureCache::printStats() const noexcept {
+		std::cout << "Texture Cache: " << stats.count << " images, " << stats.bytes / 1024 << "/" << budget / 1024 << "kb, "
+			<< stats.hits << " hits, " << stats.misses << " misses, " << stats.evictions << " evictions\n";
+	}
+
+	size_t TextureCache::getByteSize(const ImageData &img) noexcept {
+		if (img.clip.w <= 0)
+			return getTextureBytes(img.texture.get());
+
+		// pages are always ARGB8888
+		return static_cast<size_t>(img.clip.w) * img.clip.h * 4;
+	}
+
+	void TextureCache::evict(size_t limit) {
+		auto iter = recentList.end();
+		while (stats.bytes > limit && iter != recentList.begin()) {
+			--iter;
+			auto entry = entries.find(*iter);
+			// still drawn somewhere, it would stay in memory anyway
+			if (entry->second.image.use_count() > 1)
+				continue;
+
+			stats.bytes -= entry->second.bytes;
+			entries.erase(entry);
+			iter = recentList.erase(iter);
+			++stats.evictions;
+		}
+
+		stats.count = entries.size();
+	}
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SDL.h>
+#include "data.hpp"
+#include "resample.hpp"
+#include <list>
+#include <string>
+#include <unordered_map>
+
+/** Structure
+ *
+ * key -> a hash of everything the texture was made from (path & colour key, path & scaled size, or text, font, size, colours & outline)
+ * TextureCache -> owns the cached images & how many bytes each one takes
+ *
+ *	[ most recent ] <-> [ ... ] <-> [ least recent ]   <- evicted from here once the budget is exceeded
+ *
+ *  images that are still held somewhere else are skipped, dropping them wouldn't free anything
+ */
+
+namespace Application::Helper {
+	struct CacheStats final {
+		uint64_t hits {0};
+		uint64_t misses {0};
+		uint64_t evictions {0};
+		// bytes of every cached texture
+		size_t bytes {0};
+		size_t count {0};
+	};
+
+	class TextureCache final {
+	public:
+		/** Create a cache.
+		 *
+		 * \param budget -> how many bytes of textures can stay cached
+		 */
+		explicit TextureCache(size_t budget = 64 * 1024 * 1024);
+		/** Gets the key of an image file (or any other named image).
+		 *
+		 * \param path -> the location of the image file
+		 * \param colorKey -> the colour that was colour keyed (nullptr if none)
+		 * \return the key.
+		 */
+		static uint64_t getKey(std::string_view path, const SDL_Color *colorKey = nullptr) noexcept;
+		/** Gets the key of an image file resampled to a size.
+		 *
+		 * \param path -> the location of the image file
+		 * \param width -> the width it was scaled to
+		 * \param height -> the height it was scaled to
+		 * \param filter -> the kernel it was scaled with
+		 * \return the key.
+		 */
+		static uint64_t getKey(std::string_view path, int width, int height, ResampleFilter filter) noexcept;
+		/** Gets the key of a text texture.
+		 *
+		 * \param msg -> the text, font, size, colours & outline it was rendered with
+		 * \param hasOutline -> the text was rendered with an outline (createTextA)
+		 * \return the key.
+		 */
+		static uint64_t getKey(const MessageData &msg, bool hasOutline) noexcept;
+		/** Look an image up, counted as a hit or a miss.
+		 *
+		 * \param key -> the key of the image
+		 * \return the image or nullptr if it's not cached.
+		 */
+		IMD find(uint64_t key);
+		/** Cache an image, replacing the one with the same key. Least recently used images are evicted when the budget is exceeded.
+		 *
+		 * \param key -> the key of the image
+		 * \param img -> the image to cache
+		 * \return the image.
+		 */
+		IMD insert(uint64_t key, IMD img);
+		/** Drop an image from the cache.
+		 *
+		 * \param img -> the image to drop
+		 * \return true if it was cached, otherwise false.
+		 */
+		bool remove(const IMD &img);
+		/** Evict least recently used images until the cache holds at most bytes, the budget is left as it is.
+		 *
+		 * \param bytes -> how many bytes of textures can stay cached
+		 * \return how many bytes were freed (images that are still held elsewhere are kept).
+		 */
+		size_t trim(size_t bytes);
+		void setBudget(size_t budget);
+		size_t getBudget() const noexcept;
+		const CacheStats &getStats() const noexcept;
+		void printStats() const noexcept;
+
+	private:
+		// atlas regions only count their part of the page
+		static size_t getByteSize(const ImageData &img) noexcept;
+		void evict(size_t limit);
+
+	private:
+		struct Entry final {
+			IMD image {nullptr};
+			size_t bytes {0};
+			std::list<uint64_t>::iterator recent {};
+		};
+
+		size_t budget {0};
+		CacheStats stats {};
+		std::unordered_map<uint64_t, Entry> entries {};
+		// most recently used first
+		std::list<uint64_t> recentList {};
+	};
+} // namespace Application::Helper
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "timeformat.hpp"
+
+namespace Application::Helper {
+	std::chrono::sys_seconds TimeFormat::toLocal(const std::chrono::system_clock::time_point &time) {
+		const auto seconds = std::chrono::floor<std::chrono::seconds>(time);
+
+		// only look the zone up again once a transition (or a clock jump) leaves the cached window
+		if (seconds < zoneBegin || seconds >= zoneEnd) {
+			const auto info = std::chrono::current_zone()->get_info(seconds);
+			zoneBegin = info.begin;
+			zoneEnd = info.end;
+			zoneOffset = info.offset;
+		}
+
+		return seconds + zoneOffset;
+	}
+
+	std::string_view TimeFormat::time(const std::chrono::system_clock::time_point &time) {
+		const auto local = toLocal(time);
+		const std::chrono::hh_mm_ss hms {local - std::chrono::floor<std::chrono::days>(local)};
+
+		const auto hour = std::chrono::make12(hms.hours()).count();
+		const auto minute = hms.minutes().count();
+
+		timeBuffer[0] = digits[hour][0];
+		timeBuffer[1] = digits[hour][1];
+		timeBuffer[2] = ':';
+		timeBuffer[3] = digits[minute][0];
+		timeBuffer[4] = digits[minute][1];
+		timeBuffer[5] = std::chrono::is_pm(hms.hours()) ? 'P' : 'A';
+		timeBuffer[6] = 'M';
+
+		return {timeBuffer.data(), timeBuffer.size()};
+	}
+
+	std::string_view TimeFormat::date(const std::chrono::system_clock::time_point &time) {
+		const std::chrono::year_month_day ymd {std::chrono::floor<std::chrono::days>(toLocal(time))};
+
+		const auto month = static_cast<unsigned>(ymd.month());
+		const auto day = static_cast<unsigned>(ymd.day());
+		// %y is the last two digits of the year
+		const auto year = ((static_cast<int>(ymd.year()) % 100) + 100) % 100;
+
+		dateBuffer[0] = digits[month][0];
+		dateBuffer[1] = digits[month][1];
+		dateBuffer[2] = '/';
+		dateBuffer[3] = digits[day][0];
+		dateBuffer[4] = digits[day][1];
+		dateBuffer[5] = '/';
+		dateBuffer[6] = digits[year][0];
+		dateBuffer[7] = digits[year][1];
+
+		return {dateBuffer.data(), dateBuffer.size()};
+	}
+} // namespace Application::Helper
\ No newline at end of file
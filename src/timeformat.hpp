@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string_view>
+
+/** Structure
+ *
+ * TimeFormat -> formats the clock & date into fixed buffers, the local zone offset is cached
+ *               until the next DST transition so the tzdb is only walked when the offset changes
+ *
+ *	time -> "hh:mmAM" ({:%OI:%M}AM)
+ *	date -> "MM/DD/YY" ({:%Ex})
+ */
+
+namespace Application::Helper {
+	class TimeFormat final {
+	public:
+		/** Formats the 12-hour time with an AM/PM suffix.
+		 *
+		 * \param time -> the time to format (converted to the local zone)
+		 * \return a view of the formatted time, valid until the next call.
+		 */
+		std::string_view time(const std::chrono::system_clock::time_point &time);
+		/** Formats the date the same way as {:%Ex} in the "C" locale.
+		 *
+		 * \param time -> the time to format (converted to the local zone)
+		 * \return a view of the formatted date, valid until the next call.
+		 */
+		std::string_view date(const std::chrono::system_clock::time_point &time);
+
+	private:
+		std::chrono::sys_seconds toLocal(const std::chrono::system_clock::time_point &time);
+
+	private:
+		// two characters per number from 00 to 99
+		static constexpr std::array<std::array<char, 2>, 100> digits = [] {
+			std::array<std::array<char, 2>, 100> table {};
+			for (int i = 0; i < 100; ++i)
+				table[i] = {static_cast<char>('0' + i / 10), static_cast<char>('0' + i % 10)};
+			return table;
+		}();
+
+		// the window where the cached offset is valid [begin, end)
+		std::chrono::sys_seconds zoneBegin {std::chrono::sys_seconds::max()};
+		std::chrono::sys_seconds zoneEnd {std::chrono::sys_seconds::min()};
+		std::chrono::seconds zoneOffset {0};
+
+		std::array<char, 7> timeBuffer {};
+		std::array<char, 8> dateBuffer {};
+	};
+} // namespace Application::Helper
\ No newline at end of file
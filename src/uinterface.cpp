@@ -1,54 +1,109 @@
 #include "uinterface.hpp"
 #include "util.hpp"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <format>
 
 namespace Application::Helper {
-	BUTTONPTR UInterface::createButton(std::string_view text, IMD texture, int x, int y, uint32_t w, uint32_t h) {
-		BUTTONPTR newButton = std::make_shared<Button>();
+	UInterface::UInterface(std::shared_ptr<RenderQueue> queue, std::shared_ptr<Text> text) : queuePtr(std::move(queue)), textPtr(std::move(text)) {}
 
-		newButton->box = {x, y, static_cast<int>(w), static_cast<int>(h)};
+	ButtonHandle UInterface::addButton(std::string_view text, int x, int y, uint32_t w, uint32_t h) {
+		MemoryScope scope {MemoryTag::UInterface};
 
-		newButton->text = text;
-		if (texture != nullptr)
-			newButton->texture = *texture;
+		uint32_t index = 0;
+		if (!freeSlots.empty()) {
+			index = freeSlots.back();
+			freeSlots.pop_back();
+		} else {
+			index = static_cast<uint32_t>(generations.size());
+			boxX.emplace_back();
+			boxY.emplace_back();
+			boxW.emplace_back();
+			boxH.emplace_back();
+			alphas.emplace_back();
+			enabled.emplace_back();
+			colors.emplace_back();
+			textures.emplace_back();
+			clips.emplace_back();
+			texts.emplace_back();
+			scenes.emplace_back();
+			callbacks.emplace_back();
+			generations.emplace_back(0);
+		}
 
-		btnList.emplace_back(newButton);
+		boxX[index] = x;
+		boxY[index] = y;
+		boxW[index] = static_cast<int>(w);
+		boxH[index] = static_cast<int>(h);
+		alphas[index] = minAlpha;
+		enabled[index] = false;
+		colors[index] = {};
+		textures[index] = nullptr;
+		clips[index] = {0, 0, 0, 0};
+		texts[index] = text;
+		scenes[index] = SceneID::Main;
+		callbacks[index] = nullptr;
+		++generations[index];
+
+		return {index, generations[index]};
+	}
+
+	ButtonHandle UInterface::createButton(std::string_view text, IMD texture, int x, int y, uint32_t w, uint32_t h) {
+		ButtonHandle newButton = addButton(text, x, y, w, h);
+		if (texture != nullptr)
+			setButtonTexture(newButton, texture);
 
 		return newButton;
 	}
 
-	BUTTONPTR UInterface::createButton(std::string_view text, int x, int y, uint32_t w, uint32_t h) {
-		BUTTONPTR newButton = std::make_shared<Button>();
+	ButtonHandle UInterface::createButton(std::string_view text, int x, int y, uint32_t w, uint32_t h) {
+		return addButton(text, x, y, w, h);
+	}
 
-		newButton->box = {x, y, static_cast<int>(w), static_cast<int>(h)};
-		newButton->text = text;
+	void UInterface::removeButton(ButtonHandle button) {
+		if (!isValid(button))
+			return;
 
-		btnList.emplace_back(newButton);
+		const uint32_t index = button.index;
+		boxW[index] = -1;
+		boxH[index] = -1;
+		enabled[index] = false;
+		textures[index] = nullptr;
+		texts[index].clear();
+		callbacks[index] = nullptr;
+		// skip 0 when the generation wraps around, it marks invalid handles
+		if (++generations[index] == 0)
+			generations[index] = 1;
+		freeSlots.emplace_back(index);
+		hitGridsAreDirty = true;
+	}
 
-		return newButton;
+	bool UInterface::isValid(ButtonHandle button) const noexcept {
+		return button.generation != 0 && button.index < generations.size() && generations[button.index] == button.generation && boxW[button.index] >= 0;
 	}
 
-	std::vector<BUTTONPTR> &UInterface::getButtonList() {
-		return btnList;
+	size_t UInterface::getButtonCount() const noexcept {
+		return generations.size() - freeSlots.size();
 	}
 
 	SDL_Point &UInterface::getMousePos() {
 		return mousePos;
 	}
 
-	void UInterface::setButtonTexture(BUTTONPTR &button, IMD &texture) {
-		button->texture = *texture;
+	void UInterface::setButtonTexture(ButtonHandle button, IMD &texture) {
+		SDL_assert(isValid(button));
+		textures[button.index] = texture->texture;
+		clips[button.index] = texture->clip;
 	}
 
-	bool UInterface::cursorInBounds(BUTTONPTR &button, SDL_Point &mousePos) {
-		if (mousePos.x >= button->box.x && mousePos.x <= (button->box.x + button->box.w) &&
-			mousePos.y >= button->box.y && mousePos.y <= (button->box.y + button->box.h)) {
-			return true;
-		}
+	bool UInterface::cursorInBounds(ButtonHandle button, const SDL_Point &mousePos) const noexcept {
+		if (!isValid(button))
+			return false;
 
-		return false;
+		const uint32_t i = button.index;
+		return mousePos.x >= boxX[i] && mousePos.x <= (boxX[i] + boxW[i]) && mousePos.y >= boxY[i] && mousePos.y <= (boxY[i] + boxH[i]);
 	}
 
 	// make the text in the button independent
@@ -59,74 +114,236 @@ namespace Application::Helper {
 		}
 	}
 
-	void UInterface::setButtonTheme(BUTTONPTR &button, ColorData color) {
-		button->buttonColor = color;
+	void UInterface::setButtonTextSize(TextRun &buttonText, int w, int h) {
+		buttonText.imageWidth = w;
+		buttonText.imageHeight = h;
 	}
 
-	void UInterface::setButtonPos(BUTTONPTR &button, int x, int y) {
-		button->box.x = x;
-		button->box.y = y;
+	void UInterface::setButtonTheme(ButtonHandle button, ColorData color) {
+		SDL_assert(isValid(button));
+		colors[button.index] = color;
 	}
 
-	void UInterface::setButtonSize(BUTTONPTR &button, uint32_t w, uint32_t h) {
-		button->box.w = w;
-		button->box.h = h;
+	void UInterface::setTheme(ColorData color) {
+		std::fill(colors.begin(), colors.end(), color);
 	}
 
-	void UInterface::update(SDL_Event *ev, double dt) {
-		switch (ev->type) {
-			case SDL_MOUSEMOTION: {
-				mousePos.x = ev->motion.x;
-				mousePos.y = ev->motion.y;
-			} break;
+	const ColorData &UInterface::getButtonTheme(ButtonHandle button) const {
+		SDL_assert(isValid(button));
+		return colors[button.index];
+	}
+
+	void UInterface::setButtonPos(ButtonHandle button, int x, int y) {
+		SDL_assert(isValid(button));
+		boxX[button.index] = x;
+		boxY[button.index] = y;
+		hitGridsAreDirty = true;
+	}
+
+	void UInterface::setButtonSize(ButtonHandle button, uint32_t w, uint32_t h) {
+		SDL_assert(isValid(button));
+		boxW[button.index] = static_cast<int>(w);
+		boxH[button.index] = static_cast<int>(h);
+		hitGridsAreDirty = true;
+	}
+
+	SDL_Rect UInterface::getButtonBox(ButtonHandle button) const {
+		SDL_assert(isValid(button));
+		return {boxX[button.index], boxY[button.index], boxW[button.index], boxH[button.index]};
+	}
+
+	float UInterface::getButtonAlpha(ButtonHandle button) const {
+		SDL_assert(isValid(button));
+		return alphas[button.index];
+	}
+
+	void UInterface::setButtonEnabled(ButtonHandle button, bool isEnabled) {
+		SDL_assert(isValid(button));
+		enabled[button.index] = isEnabled;
+	}
+
+	bool UInterface::isButtonEnabled(ButtonHandle button) const {
+		return isValid(button) && enabled[button.index];
+	}
+
+	std::basic_string<char> &UInterface::getButtonText(ButtonHandle button) {
+		SDL_assert(isValid(button));
+		return texts[button.index];
+	}
+
+	void UInterface::setButtonCallback(ButtonHandle button, SceneID scene, std::function<void()> onClick) {
+		SDL_assert(isValid(button));
+		scenes[button.index] = scene;
+		callbacks[button.index] = std::move(onClick);
+		hitGridsAreDirty = true;
+	}
+
+	void UInterface::buildHitGrids() {
+		MemoryScope scope {MemoryTag::UInterface};
+
+		hitGrids.clear();
+
+		// the grid of every scene covers its buttons (the bounds are inclusive, like cursorInBounds)
+		for (uint32_t i = 0; i < generations.size(); ++i) {
+			if (!callbacks[i] || boxW[i] < 0)
+				continue;
+
+			HitGrid &grid = hitGrids[scenes[i]];
+			grid.columns = std::max(grid.columns, std::max(boxX[i] + boxW[i], 0) / cellSize + 1);
+			grid.rows = std::max(grid.rows, std::max(boxY[i] + boxH[i], 0) / cellSize + 1);
 		}
 
-		for (auto &button : getButtonList()) {
-			if (cursorInBounds(button, getMousePos())) {
-				button->colorAlpha += 0.35f * static_cast<float>(dt);
-				if (button->colorAlpha >= SDL_ALPHA_OPAQUE)
-					button->colorAlpha = SDL_ALPHA_OPAQUE;
-			} else {
-				button->colorAlpha -= 0.35f * static_cast<float>(dt);
-				if (button->colorAlpha <= 191.25f)
-					button->colorAlpha = 191.25f;
+		for (auto &[scene, grid] : hitGrids)
+			grid.cells.resize(static_cast<size_t>(grid.columns) * grid.rows);
+
+		for (uint32_t i = 0; i < generations.size(); ++i) {
+			if (!callbacks[i] || boxW[i] < 0)
+				continue;
+
+			HitGrid &grid = hitGrids[scenes[i]];
+			const int left = std::max(boxX[i], 0) / cellSize;
+			const int top = std::max(boxY[i], 0) / cellSize;
+			const int right = std::max(boxX[i] + boxW[i], 0) / cellSize;
+			const int bottom = std::max(boxY[i] + boxH[i], 0) / cellSize;
+			for (int y = top; y <= bottom; ++y) {
+				for (int x = left; x <= right; ++x)
+					grid.cells[static_cast<size_t>(y) * grid.columns + x].emplace_back(i);
 			}
 		}
+
+		hitGridsAreDirty = false;
 	}
 
-	void UInterface::draw(BUTTONPTR &button, IMD buttonText, SDL_Renderer *ren, double scaleX, double scaleY) {
-		SDL_Rect dst = {button->box.x, button->box.y, button->box.w, button->box.h};
-		SDL_Rect textDst = {};
-		if (buttonText != nullptr) {
-			textDst = {
-				button->box.x - (buttonText->imageWidth / 2),
-				button->box.y - (buttonText->imageHeight / 2),
-				button->box.w + buttonText->imageWidth,
-				button->box.h + buttonText->imageHeight
-			}; // modify the text dims here
+	ButtonHandle UInterface::hitTest(SceneID scene, SDL_Point pos) {
+		if (hitGridsAreDirty)
+			buildHitGrids();
+
+		auto iter = hitGrids.find(scene);
+		if (iter == hitGrids.end() || pos.x < 0 || pos.y < 0)
+			return {};
+
+		const HitGrid &grid = iter->second;
+		const int column = pos.x / cellSize;
+		const int row = pos.y / cellSize;
+		if (column >= grid.columns || row >= grid.rows)
+			return {};
+
+		// buttons created later are drawn on top
+		const auto &cell = grid.cells[static_cast<size_t>(row) * grid.columns + column];
+		for (auto index = cell.rbegin(); index != cell.rend(); ++index) {
+			const ButtonHandle button {*index, generations[*index]};
+			if (enabled[*index] && cursorInBounds(button, pos))
+				return button;
+		}
+
+		return {};
+	}
+
+	bool UInterface::click(SceneID scene, SDL_Point pos) {
+		const ButtonHandle button = hitTest(scene, pos);
+		if (!button)
+			return false;
+
+		// the callback may create or remove buttons, don't hold a reference into the array
+		const auto onClick = callbacks[button.index];
+		onClick();
+
+		return true;
+	}
+
+	void UInterface::handleEvent(const SDL_Event &ev) noexcept {
+		switch (ev.type) {
+			case SDL_MOUSEMOTION: {
+				mousePos.x = ev.motion.x;
+				mousePos.y = ev.motion.y;
+			} break;
+
+			// clicks carry their own position, motion before them may have been merged away
+			case SDL_MOUSEBUTTONDOWN:
+			case SDL_MOUSEBUTTONUP: {
+				mousePos.x = ev.button.x;
+				mousePos.y = ev.button.y;
+			} break;
 		}
+	}
+
+	bool UInterface::update(double dt) {
+		const int mx = mousePos.x;
+		const int my = mousePos.y;
+		const float step = 0.35f * static_cast<float>(dt);
+		const size_t count = alphas.size();
+
+		// branchless over the box & alpha arrays only, so it stays a flat (vectorizable) loop
+		bool isFading = false;
+		for (size_t i = 0; i < count; ++i) {
+			const bool isHovered = (mx >= boxX[i]) & (mx <= boxX[i] + boxW[i]) & (my >= boxY[i]) & (my <= boxY[i] + boxH[i]);
+			const float previousAlpha = alphas[i];
+			alphas[i] = std::clamp(previousAlpha + (isHovered ? step : -step), minAlpha, static_cast<float>(SDL_ALPHA_OPAQUE));
+			isFading |= alphas[i] != previousAlpha;
+		}
+
+		return isFading;
+	}
+
+	SDL_Rect UInterface::getTextRect(uint32_t index, int w, int h) const noexcept {
+		return {
+			boxX[index] - (w / 2),
+			boxY[index] - (h / 2),
+			boxW[index] + w,
+			boxH[index] + h
+		}; // modify the text dims here
+	}
+
+	void UInterface::drawBody(uint32_t index, SDL_Renderer *ren, double scaleX, double scaleY) {
+		const int x = boxX[index];
+		const int y = boxY[index];
+		const int w = boxW[index];
+		const int h = boxH[index];
+		SDL_Rect dst = {x, y, w, h};
 
-		if ((scaleX && scaleY) != 0) {
-			dst.w *= static_cast<int>(scaleX);
-			dst.h *= static_cast<int>(scaleY);
+		if (scaleX != 0.0 && scaleY != 0.0) {
+			dst.w = static_cast<int>(std::lround(w * scaleX));
+			dst.h = static_cast<int>(std::lround(h * scaleY));
 		}
 
+		// the body & both outlines end up in the same batch
+		const ColorData &buttonColor = colors[index];
+		const uint8_t alpha = static_cast<uint8_t>(alphas[index]);
+		const SDL_Color outlineColor {buttonColor.outlineColor.r, buttonColor.outlineColor.g, buttonColor.outlineColor.b, alpha};
+
 		// button background colour
-		SDL_SetRenderDrawColor(ren, button->buttonColor.bgColor.r, button->buttonColor.bgColor.g, button->buttonColor.bgColor.b, (uint8_t)button->colorAlpha);
-		SDL_RenderFillRect(ren, &dst);
+		queuePtr->fillRect(ren, dst, {buttonColor.bgColor.r, buttonColor.bgColor.g, buttonColor.bgColor.b, alpha});
+
+		SDL_Rect innerOutline = {x - 1, y - 1, w + 2, h + 2};
+		queuePtr->drawRect(ren, innerOutline, outlineColor);
 
-		SDL_Rect innerOutline = {button->box.x - 1, button->box.y - 1, button->box.w + 2, button->box.h + 2};
-		SDL_SetRenderDrawColor(ren, button->buttonColor.outlineColor.r, button->buttonColor.outlineColor.g, button->buttonColor.outlineColor.b, (uint8_t)button->colorAlpha);
-		SDL_RenderDrawRect(ren, &innerOutline);
+		SDL_Rect outerOutline = {x - 2, y - 2, w + 4, h + 4};
+		queuePtr->drawRect(ren, outerOutline, outlineColor);
+
+		// icons are atlas regions
+		const SDL_Rect *clip = clips[index].w > 0 ? &clips[index] : nullptr;
+		queuePtr->copy(ren, textures[index].get(), clip, dst);
+	}
 
-		SDL_Rect outerOutline = {button->box.x - 2, button->box.y - 2, button->box.w + 4, button->box.h + 4};
-		SDL_SetRenderDrawColor(ren, button->buttonColor.outlineColor.r, button->buttonColor.outlineColor.g, button->buttonColor.outlineColor.b, (uint8_t)button->colorAlpha);
-		SDL_RenderDrawRect(ren, &outerOutline);
+	void UInterface::draw(ButtonHandle button, IMD buttonText, SDL_Renderer *ren, double scaleX, double scaleY) {
+		if (!isValid(button))
+			return;
 
-		SDL_RenderCopy(ren, button->texture.texture.get(), nullptr, &dst);
+		drawBody(button.index, ren, scaleX, scaleY);
 
 		if (buttonText != nullptr) {
-			SDL_RenderCopy(ren, buttonText->texture.get(), nullptr, &textDst);
+			SDL_Rect textDst = getTextRect(button.index, buttonText->imageWidth, buttonText->imageHeight);
+			queuePtr->copy(ren, buttonText->texture.get(), nullptr, textDst);
 		}
 	}
+
+	void UInterface::draw(ButtonHandle button, const TextRun &buttonText, SDL_Renderer *ren, double scaleX, double scaleY) {
+		if (!isValid(button))
+			return;
+
+		drawBody(button.index, ren, scaleX, scaleY);
+
+		if (textPtr != nullptr)
+			textPtr->draw(buttonText, ren, getTextRect(button.index, buttonText.imageWidth, buttonText.imageHeight));
+	}
 } // namespace Application::Helper
\ No newline at end of file
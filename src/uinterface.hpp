@@ -2,28 +2,48 @@
 
 #include <SDL.h>
 #include "data.hpp"
+#include "renderqueue.hpp"
+#include "scene.hpp"
+#include "text.hpp"
+#include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
-class Scene;
+/** Structure
+ *
+ * ButtonHandle -> refers to a button slot, the generation tells a removed (reused) slot apart
+ * UInterface -> stores every button field in its own array (boxes, alphas, colours, flags, textures, ...)
+ * HitGrid -> a uniform grid per scene, each cell lists the buttons overlapping it in creation (draw) order
+ *
+ *	boxX   [ 5 | 103 | 85 | 67 | ... ]     the hover fade & hit tests only walk the arrays they need
+ *	alphas [ . |  .  | .  | .  | ... ]
+ *
+ *	-----------------
+ *	| 0,1 | 1 |     |      a click only looks at the cell under the cursor,
+ *	|-----|---|-----|      the last enabled button containing it is the topmost one
+ *	| 2   |   | 3   |
+ *	-----------------
+ */
 
 namespace Application::Helper {
-	struct Button {
-		SDL_Rect box {0};
-		ImageData texture {};
-		ColorData buttonColor {};
-		// 75% of 255
-		float colorAlpha {191.25f};
-		std::basic_string<char> text {};
-		bool canMinimize {false};
-		bool canQuit {false};
-		bool isEnabled {false};
-	};
+	struct ButtonHandle final {
+		uint32_t index {0};
+		// 0 is never a live generation
+		uint32_t generation {0};
 
-	using BUTTONPTR = std::shared_ptr<Button>;
+		explicit operator bool() const noexcept {return generation != 0;}
+		bool operator==(const ButtonHandle &) const = default;
+	};
 
 	class UInterface final {
 	public:
+		/** Create the interface.
+		 *
+		 * \param queue -> the queue buttons are submitted to
+		 * \param text -> the glyph atlas used to draw button text runs
+		 */
+		explicit UInterface(std::shared_ptr<RenderQueue> queue, std::shared_ptr<Text> text = nullptr);
 		/** Create a button with a texture.
 		 *
 		 * \param text -> the text within the button
@@ -32,9 +52,9 @@ namespace Application::Helper {
 		 * \param y -> y position of the button
 		 * \param w -> width of the button
 		 * \param h -> height of the button
-		 * \return Button object filled with all of the essential details for a customized button.
+		 * \return the handle of the button.
 		 */
-		BUTTONPTR createButton(std::string_view text, IMD texture, int x, int y, uint32_t w, uint32_t h);
+		ButtonHandle createButton(std::string_view text, IMD texture, int x, int y, uint32_t w, uint32_t h);
 		/** Create a normal button.
 		 *
 		 * \param text -> the text within the button
@@ -42,22 +62,109 @@ namespace Application::Helper {
 		 * \param y -> y position of the button
 		 * \param w -> width of the button
 		 * \param h -> height of the button
-		 * \return Button object filled with all of the essential details for a customized button.
+		 * \return the handle of the button.
+		 */
+		ButtonHandle createButton(std::string_view text, int x, int y, uint32_t w, uint32_t h);
+		/** Remove a button, its slot is reused & old handles to it become invalid.
+		 *
+		 * \param button -> the button to remove
 		 */
-		BUTTONPTR createButton(std::string_view text, int x, int y, uint32_t w, uint32_t h);
-		std::vector<BUTTONPTR> &getButtonList();
+		void removeButton(ButtonHandle button);
+		bool isValid(ButtonHandle button) const noexcept;
+		size_t getButtonCount() const noexcept;
 		SDL_Point &getMousePos();
-		bool cursorInBounds(BUTTONPTR &button, SDL_Point &mousePos);
+		bool cursorInBounds(ButtonHandle button, const SDL_Point &mousePos) const noexcept;
 		void setButtonTextSize(IMD &buttonText, int w, int h);
-		void setButtonTheme(BUTTONPTR &button, ColorData color);
-		void setButtonPos(BUTTONPTR &button, int x, int y);
-		void setButtonSize(BUTTONPTR &button, uint32_t w, uint32_t h);
-		void setButtonTexture(BUTTONPTR &button, IMD &texture);
-		void update(SDL_Event *ev, double dt);
-		void draw(BUTTONPTR &button, IMD buttonText, SDL_Renderer *ren, double sx = 0.0, double sy = 0.0);
+		void setButtonTextSize(TextRun &buttonText, int w, int h);
+		void setButtonTheme(ButtonHandle button, ColorData color);
+		// sets the theme of every button
+		void setTheme(ColorData color);
+		const ColorData &getButtonTheme(ButtonHandle button) const;
+		void setButtonPos(ButtonHandle button, int x, int y);
+		void setButtonSize(ButtonHandle button, uint32_t w, uint32_t h);
+		SDL_Rect getButtonBox(ButtonHandle button) const;
+		// the hover fade, from 75% to fully opaque
+		float getButtonAlpha(ButtonHandle button) const;
+		void setButtonTexture(ButtonHandle button, IMD &texture);
+		void setButtonEnabled(ButtonHandle button, bool isEnabled);
+		bool isButtonEnabled(ButtonHandle button) const;
+		std::basic_string<char> &getButtonText(ButtonHandle button);
+		/** Register what a button does when it's clicked.
+		 *
+		 * \param button -> the button to register
+		 * \param scene -> the scene the button can be clicked in
+		 * \param onClick -> the callback to run
+		 */
+		void setButtonCallback(ButtonHandle button, SceneID scene, std::function<void()> onClick);
+		/** Find the topmost enabled button with a callback under a point.
+		 *
+		 * \param scene -> the scene that is shown
+		 * \param pos -> the point to test
+		 * \return the button or an invalid handle if there's none.
+		 */
+		ButtonHandle hitTest(SceneID scene, SDL_Point pos);
+		/** Run the callback of the button under a point.
+		 *
+		 * \param scene -> the scene that is shown
+		 * \param pos -> the point that was clicked
+		 * \return true if a button handled the click, otherwise false.
+		 */
+		bool click(SceneID scene, SDL_Point pos);
+		/** Updates the cursor position, call it for every event before acting on it.
+		 *
+		 * \param ev -> the event to handle
+		 */
+		void handleEvent(const SDL_Event &ev) noexcept;
+		/** Updates the hover fade of every button, once per frame.
+		 *
+		 * \param dt -> the time since the last update
+		 * \return true if any button changed its look (a fade is still running), otherwise false.
+		 */
+		bool update(double dt);
+		void draw(ButtonHandle button, IMD buttonText, SDL_Renderer *ren, double sx = 0.0, double sy = 0.0);
+		void draw(ButtonHandle button, const TextRun &buttonText, SDL_Renderer *ren, double sx = 0.0, double sy = 0.0);
+
+	private:
+		ButtonHandle addButton(std::string_view text, int x, int y, uint32_t w, uint32_t h);
+		void drawBody(uint32_t index, SDL_Renderer *ren, double sx, double sy);
+		SDL_Rect getTextRect(uint32_t index, int w, int h) const noexcept;
+		void buildHitGrids();
 
 	private:
-		std::vector<BUTTONPTR> btnList {};
+		struct HitGrid final {
+			int columns {0};
+			int rows {0};
+			// button slots
+			std::vector<std::vector<uint32_t>> cells {};
+		};
+
+		static constexpr int cellSize {16};
+		// 75% of 255
+		static constexpr float minAlpha {191.25f};
+
+		std::shared_ptr<RenderQueue> queuePtr {nullptr};
+		std::shared_ptr<Text> textPtr {nullptr};
+
+		// one entry per slot, removed slots keep a negative size so they are never hovered or hit
+		std::vector<int> boxX {};
+		std::vector<int> boxY {};
+		std::vector<int> boxW {};
+		std::vector<int> boxH {};
+		std::vector<float> alphas {};
+		std::vector<uint8_t> enabled {};
+		std::vector<ColorData> colors {};
+		std::vector<std::shared_ptr<SDL_Texture>> textures {};
+		std::vector<SDL_Rect> clips {};
+		std::vector<std::basic_string<char>> texts {};
+		// the scene the button is clicked in & what happens (see setButtonCallback)
+		std::vector<SceneID> scenes {};
+		std::vector<std::function<void()>> callbacks {};
+		std::vector<uint32_t> generations {};
+		std::vector<uint32_t> freeSlots {};
+
 		SDL_Point mousePos {};
+		std::unordered_map<SceneID, HitGrid> hitGrids {};
+		// rebuilt on the next click after a box or callback changed
+		bool hitGridsAreDirty {true};
 	};
 } // namespace Application::Helper
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SDL.h>
+#include "memstats.hpp"
 #include <memory>
 #include <concepts>
 
@@ -8,7 +9,7 @@ namespace Application::Helper::Utilities {
 	struct Memory final {
 		void operator()(SDL_Window *x) const {SDL_DestroyWindow(x);}
 		void operator()(SDL_Renderer *x) const {SDL_DestroyRenderer(x);}
-		void operator()(SDL_Texture *x) const {SDL_DestroyTexture(x);}
+		void operator()(SDL_Texture *x) const {untrackTexture(x); SDL_DestroyTexture(x);}
 	};
 
 	template <typename T> using PTR = std::unique_ptr<T, Memory>;
@@ -0,0 +1,127 @@
+#include <SDL.h>
+#include "anya.hpp"
+#include "memstats.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// boots the app headless (dummy video driver, software renderer) & replays an event trace as fast as it can
+// usage: time_bench [frames] [trace]
+// the trace defaults to session.trace next to the executable, any session recorded with --record=<file> works
+
+using namespace Application;
+
+static int64_t getPeakRSS() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters {};
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return static_cast<int64_t>(counters.PeakWorkingSetSize);
+#else
+	rusage usage {};
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+		return static_cast<int64_t>(usage.ru_maxrss);
+#else
+		// kilobytes everywhere but macOS
+		return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+	}
+#endif
+	return 0;
+}
+
+// nearest rank of the sorted samples
+static double getPercentile(const std::vector<double> &sorted, double percentile) {
+	if (sorted.empty())
+		return 0.0;
+
+	const size_t rank = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1) + 0.5);
+	return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+int main(int argc, char **argv) {
+	const int frames = argc > 1 ? std::atoi(argv[1]) : 2000;
+	if (frames <= 0) {
+		std::cout << "usage: " << argv[0] << " [frames] [trace]\n";
+		return 1;
+	}
+
+	std::basic_string<char> tracePath {};
+	if (argc > 2) {
+		tracePath = argv[2];
+	} else {
+		char *const base = SDL_GetBasePath();
+		tracePath = std::basic_string<char>(base != nullptr ? base : "") + "session.trace";
+		SDL_free(base);
+	}
+
+	// no window has to be shown, SDL_VIDEODRIVER=offscreen (or a real driver) still wins when it's set
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+
+	std::basic_string<char> replayOption = "--replay=" + tracePath;
+	std::vector<char *> options {
+		argv[0],
+		const_cast<char *>("--renderer=software"),
+		const_cast<char *>("--vsync=off"),
+		const_cast<char *>("--unpaced"),
+		replayOption.data()
+	};
+
+	Anya app(static_cast<int>(options.size()), options.data(), false);
+	if (!app.boot()) {
+		std::cout << "Failed to boot the app\n";
+		return 1;
+	}
+
+	std::vector<double> latencies {};
+	latencies.reserve(frames);
+	int64_t drawCalls = 0;
+
+	// boot allocations aren't part of a frame
+	const int64_t allocationsBefore = Helper::getAllocationCount();
+	const int missedBefore = app.getMissedDeadlines();
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < frames; ++i) {
+		const auto frameStart = std::chrono::steady_clock::now();
+		const bool isRunning = app.step();
+		latencies.emplace_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+		// unpaced, every iteration presents a frame
+		drawCalls += app.getDrawCallCount();
+
+		if (!isRunning)
+			break;
+	}
+
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	const int64_t allocations = Helper::getAllocationCount() - allocationsBefore;
+	// frames slower than the app's target rate, even though the bench doesn't wait for it
+	const int missedDeadlines = app.getMissedDeadlines() - missedBefore;
+	const bool isReplaying = app.isReplaying();
+	const int64_t peakRSS = getPeakRSS();
+
+	app.free();
+
+	std::sort(latencies.begin(), latencies.end());
+	const double count = static_cast<double>(latencies.size());
+
+	std::cout << "trace: " << tracePath << (isReplaying ? " (not finished, run more frames)" : "") << '\n';
+	std::cout << "frames: " << latencies.size() << '\n';
+	std::cout << "fps: " << (elapsed > 0.0 ? count / elapsed : 0.0) << '\n';
+	std::cout << "latency (ms): p50 " << getPercentile(latencies, 0.5) << ", p90 " << getPercentile(latencies, 0.9)
+			  << ", p99 " << getPercentile(latencies, 0.99) << ", max " << (latencies.empty() ? 0.0 : latencies.back()) << '\n';
+	std::cout << "draw calls per frame: " << (count > 0.0 ? static_cast<double>(drawCalls) / count : 0.0) << '\n';
+	std::cout << "missed deadlines: " << missedDeadlines << '\n';
+	std::cout << "allocations per frame: " << (count > 0.0 ? static_cast<double>(allocations) / count : 0.0) << '\n';
+	std::cout << "peak rss (MiB): " << static_cast<double>(peakRSS) / (1024.0 * 1024.0) << '\n';
+
+	return 0;
+}
\ No newline at end of file
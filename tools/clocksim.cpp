@@ -0,0 +1,151 @@
+#include <SDL.h>
+#include "anya.hpp"
+#include "clock.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <format>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// simulates a whole day of the clock as fast as the loop runs (dummy video driver, software renderer)
+// usage: time_clocksim [YYYY-MM-DD]
+// every minute of the local day is shown once, plus the seconds around the DST transitions of the day & the next two of the zone,
+// each frame's time is checked against the zone database & the cost of every frame is reported (rollovers on their own)
+
+using namespace Application;
+
+using TimePoint = Helper::Clock::TimePoint;
+
+// formatted without TimeFormat's cached offset, so a stale offset around a transition shows up
+static std::basic_string<char> getExpectedTime(TimePoint time) {
+	const auto local = std::chrono::zoned_time {std::chrono::current_zone(), std::chrono::floor<std::chrono::seconds>(time)}.get_local_time();
+	const std::chrono::hh_mm_ss hms {local - std::chrono::floor<std::chrono::days>(local)};
+
+	return std::format("{:02}:{:02}{}", std::chrono::make12(hms.hours()).count(), hms.minutes().count(), std::chrono::is_pm(hms.hours()) ? "PM" : "AM");
+}
+
+static std::vector<TimePoint> createScript(std::chrono::year_month_day day) {
+	const auto zone = std::chrono::current_zone();
+	const std::chrono::sys_seconds dayStart = zone->to_sys(std::chrono::local_days {day}, std::chrono::choose::earliest);
+	const std::chrono::sys_seconds dayEnd = zone->to_sys(std::chrono::local_days {day} + std::chrono::days(1), std::chrono::choose::earliest);
+
+	// a DST day has 23 or 25 hours, stepping in system time covers every minute it really has
+	std::vector<TimePoint> script {};
+	for (TimePoint time = dayStart; time < dayEnd; time += std::chrono::minutes(1))
+		script.emplace_back(time);
+
+	std::vector<std::chrono::sys_seconds> transitions {};
+	auto info = zone->get_info(dayStart);
+	while (info.end < dayEnd) {
+		transitions.emplace_back(info.end);
+		info = zone->get_info(info.end);
+	}
+	for (int i = 0; i < 2 && info.end != std::chrono::sys_seconds::max(); ++i) {
+		transitions.emplace_back(info.end);
+		info = zone->get_info(info.end);
+	}
+
+	for (const auto &transition : transitions) {
+		for (const auto offset : {std::chrono::seconds(-60), std::chrono::seconds(-1), std::chrono::seconds(0), std::chrono::seconds(1), std::chrono::seconds(60)})
+			script.emplace_back(transition + offset);
+	}
+
+	std::sort(script.begin(), script.end());
+	script.erase(std::unique(script.begin(), script.end()), script.end());
+	// the first tick moves to the second time, show the first one twice
+	script.insert(script.begin(), script.front());
+
+	return script;
+}
+
+// nearest rank of the sorted samples
+static double getPercentile(const std::vector<double> &sorted, double percentile) {
+	if (sorted.empty())
+		return 0.0;
+
+	const size_t rank = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1) + 0.5);
+	return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+static void printCost(std::string_view name, std::vector<double> &costs) {
+	std::sort(costs.begin(), costs.end());
+	std::cout << name << " (ms): p50 " << getPercentile(costs, 0.5) << ", p99 " << getPercentile(costs, 0.99)
+			  << ", max " << (costs.empty() ? 0.0 : costs.back()) << " over " << costs.size() << " frames\n";
+}
+
+int main(int argc, char **argv) {
+	auto day = std::chrono::year_month_day {std::chrono::floor<std::chrono::days>(std::chrono::current_zone()->to_local(std::chrono::system_clock::now()))};
+	if (argc > 1) {
+		int year = 0;
+		unsigned month = 0;
+		unsigned dayOfMonth = 0;
+		if (std::sscanf(argv[1], "%d-%u-%u", &year, &month, &dayOfMonth) != 3 || !std::chrono::year_month_day {std::chrono::year(year), std::chrono::month(month), std::chrono::day(dayOfMonth)}.ok()) {
+			std::cout << "usage: " << argv[0] << " [YYYY-MM-DD]\n";
+			return 1;
+		}
+		day = {std::chrono::year(year), std::chrono::month(month), std::chrono::day(dayOfMonth)};
+	}
+
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+
+	std::vector<char *> options {
+		argv[0],
+		const_cast<char *>("--renderer=software"),
+		const_cast<char *>("--vsync=off")
+	};
+
+	Anya app(static_cast<int>(options.size()), options.data(), false);
+	if (!app.boot()) {
+		std::cout << "Failed to boot the app\n";
+		return 1;
+	}
+
+	const auto script = createScript(day);
+	app.setClock(Helper::Clock(script));
+
+	std::vector<double> frameCosts {};
+	std::vector<double> rolloverCosts {};
+	std::basic_string<char> lastShown {};
+	int mismatches = 0;
+	int flips = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	while (!app.getClock().isFinished()) {
+		const auto frameStart = std::chrono::steady_clock::now();
+		const bool isRunning = app.step();
+		const double cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+
+		const std::basic_string<char> shown {app.getDisplayedTime()};
+		const auto expected = getExpectedTime(app.getClock().now());
+		if (shown != expected && ++mismatches <= 10)
+			std::cout << std::format("{:%F %T} UTC: shown {}, expected {}\n", std::chrono::floor<std::chrono::seconds>(app.getClock().now()), shown, expected);
+
+		if (shown != lastShown) {
+			if (!lastShown.empty() && shown.size() == lastShown.size() && shown.back() == 'M' && shown[shown.size() - 2] != lastShown[lastShown.size() - 2])
+				++flips;
+			rolloverCosts.emplace_back(cost);
+			lastShown = shown;
+		}
+		frameCosts.emplace_back(cost);
+
+		if (!isRunning)
+			break;
+	}
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	app.free();
+
+	std::cout << std::format("simulated {} ({} frames) in {:.2f}s\n", day, frameCosts.size(), elapsed);
+	std::cout << "AM/PM flips: " << flips << '\n';
+	printCost("frame", frameCosts);
+	printCost("rollover", rolloverCosts);
+
+	if (mismatches > 0) {
+		std::cout << mismatches << " frame(s) showed the wrong time\n";
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
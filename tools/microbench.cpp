@@ -0,0 +1,374 @@
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+#include "animation.hpp"
+#include "backend.hpp"
+#include "image.hpp"
+#include "memstats.hpp"
+#include "resample.hpp"
+#include "scene.hpp"
+#include "uinterface.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// times the hot helpers in isolation (dummy video driver, software renderer)
+// usage: time_microbench [--filter=<part of a name>] [--samples=<n>] [--out=<results.json>] [--baseline=<baseline.json>] [--threshold=<0.1>] [--allow-new]
+// without --out the results are printed as JSON, with --baseline every benchmark slower by more than the threshold fails the run
+// so does a benchmark the baseline doesn't have (or an empty baseline) unless --allow-new is passed
+//
+//	{
+//		"version": 1,
+//		"unit": "ns",
+//		"results": [
+//			{"name": "uinterface/update/100", "median": 812.4, "min": 790.1, "iterations": 8192},
+//			...
+//		]
+//	}
+//
+// one result per line in the order they ran, so results can be diffed & stored as the next baseline
+// progress, kernels & the comparison go to stderr, stdout only ever carries the JSON
+// tools/microbench.baseline.json is the stored baseline (refresh it with --out= on the reference machine)
+
+using namespace Application::Helper;
+
+struct Benchmark final {
+	std::basic_string<char> name {};
+	// a single operation, timed in batches
+	std::function<void()> run {};
+};
+
+struct Result final {
+	std::basic_string<char> name {};
+	// nanoseconds per operation
+	double median {0.0};
+	double min {0.0};
+	int64_t iterations {0};
+};
+
+// a batch has to take at least this long, so the clock resolution doesn't matter
+constexpr std::chrono::nanoseconds minBatchTime {std::chrono::milliseconds(5)};
+
+static double timeBatch(const Benchmark &bench, int64_t iterations) {
+	const auto start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < iterations; ++i)
+		bench.run();
+
+	return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+static Result measure(const Benchmark &bench, int samples) {
+	// warm up caches (glyphs, fonts, textures) before anything is counted
+	bench.run();
+
+	int64_t iterations = 1;
+	while (timeBatch(bench, iterations) < static_cast<double>(minBatchTime.count()) && iterations < (int64_t(1) << 30))
+		iterations *= 2;
+
+	std::vector<double> perOp {};
+	for (int i = 0; i < samples; ++i)
+		perOp.emplace_back(timeBatch(bench, iterations) / static_cast<double>(iterations));
+	std::sort(perOp.begin(), perOp.end());
+
+	return {bench.name, perOp[perOp.size() / 2], perOp.front(), iterations * samples};
+}
+
+static std::basic_string<char> toJSON(const std::vector<Result> &results) {
+	std::basic_string<char> json = "{\n\t\"version\": 1,\n\t\"unit\": \"ns\",\n\t\"results\": [\n";
+	for (size_t i = 0; i < results.size(); ++i) {
+		const Result &result = results[i];
+		json += std::format("\t\t{{\"name\": \"{}\", \"median\": {:.1f}, \"min\": {:.1f}, \"iterations\": {}}}{}\n",
+							result.name, result.median, result.min, result.iterations, i + 1 < results.size() ? "," : "");
+	}
+	json += "\t]\n}\n";
+
+	return json;
+}
+
+// only reads what toJSON writes: the name & median of every result line
+static bool readBaseline(std::string_view filePath, std::unordered_map<std::basic_string<char>, double> &baseline) {
+	std::ifstream file {std::basic_string<char>(filePath)};
+	if (!file) {
+		std::cerr << "Failed to open the baseline: " << filePath << '\n';
+		return false;
+	}
+
+	std::basic_string<char> line {};
+	while (std::getline(file, line)) {
+		const auto name = line.find("\"name\": \"");
+		const auto median = line.find("\"median\": ");
+		if (name == std::basic_string<char>::npos || median == std::basic_string<char>::npos)
+			continue;
+
+		const auto nameStart = name + 9;
+		const auto nameEnd = line.find('"', nameStart);
+		baseline.insert_or_assign(line.substr(nameStart, nameEnd - nameStart), std::strtod(line.c_str() + median + 10, nullptr));
+	}
+
+	return true;
+}
+
+// prints every benchmark against the baseline, returns how many regressed & counts the ones it doesn't have in missing
+static int compare(const std::vector<Result> &results, const std::unordered_map<std::basic_string<char>, double> &baseline, double threshold, int &missing) {
+	int regressions = 0;
+	for (const auto &result : results) {
+		auto findBase = baseline.find(result.name);
+		if (findBase == baseline.end() || findBase->second <= 0.0) {
+			++missing;
+			std::cerr << std::format("{:<40} {:>12.1f} ns   (new)\n", result.name, result.median);
+			continue;
+		}
+
+		const double change = result.median / findBase->second - 1.0;
+		const bool hasRegressed = change > threshold;
+		regressions += hasRegressed;
+		std::cerr << std::format("{:<40} {:>12.1f} ns   {:>+7.1f}%{}\n", result.name, result.median, change * 100.0, hasRegressed ? "   REGRESSED" : "");
+	}
+
+	return regressions;
+}
+
+int main(int argc, char **argv) {
+	std::basic_string<char> filter {};
+	std::basic_string<char> outPath {};
+	std::basic_string<char> baselinePath {};
+	double threshold = 0.1;
+	int samples = 15;
+	bool allowNew = false;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		if (arg.starts_with("--filter=")) {
+			filter = arg.substr(9);
+		} else if (arg.starts_with("--out=")) {
+			outPath = arg.substr(6);
+		} else if (arg.starts_with("--baseline=")) {
+			baselinePath = arg.substr(11);
+		} else if (arg.starts_with("--threshold=")) {
+			threshold = std::strtod(argv[i] + 12, nullptr);
+		} else if (arg.starts_with("--samples=")) {
+			samples = std::max(1, std::atoi(argv[i] + 10));
+		} else if (arg == "--allow-new") {
+			allowNew = true;
+		} else {
+			std::cerr << "usage: " << argv[0] << " [--filter=<part of a name>] [--samples=<n>] [--out=<results.json>] [--baseline=<baseline.json>] [--threshold=<0.1>] [--allow-new]\n";
+			return 1;
+		}
+	}
+
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+	if (SDL_Init(SDL_INIT_VIDEO) != 0 || IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG) == 0 || TTF_Init() == -1) {
+		std::cerr << "Failed to initialize SDL: " << SDL_GetError() << '\n';
+		return 1;
+	}
+
+	char *const base = SDL_GetBasePath();
+	const std::basic_string<char> dirPath = base != nullptr ? base : "";
+	SDL_free(base);
+
+	auto window = Utilities::PTR<SDL_Window>(SDL_CreateWindow("time_microbench", 0, 0, 148, 89, SDL_WINDOW_HIDDEN));
+	bool isVSync = false;
+	auto renderer = window ? createRenderer(window.get(), {"software", false}, isVSync) : nullptr;
+	if (renderer == nullptr) {
+		std::cerr << "Failed to create the renderer: " << SDL_GetError() << '\n';
+		return 1;
+	}
+	SDL_Renderer *ren = renderer.get();
+
+	int exitCode = 0;
+	// the helpers hold textures, they have to be gone before the renderer
+	{
+		std::vector<Benchmark> benchmarks {};
+		auto image = std::make_shared<Image>();
+		auto queue = image->getQueuePtr();
+
+		// every size draw() asks for, steady is the per-frame cost & reshape is a changed string (the clock ticking)
+		const auto fontFile = dirPath + "assets/Onest.ttf";
+		if (std::filesystem::exists(fontFile)) {
+			std::cerr << "Distance field kernels: " << getDistanceFieldKernels() << '\n';
+			for (const int size : {10, 16, 28, 32, 72, 96}) {
+				for (const bool outline : {false, true}) {
+					const auto prefix = std::format("image/{}/{}", outline ? "createTextA" : "createText", size);
+					const auto create = [image, ren, outline](const MessageData &msg, TextRun &run) {
+						outline ? image->createTextA(msg, ren, run) : image->createText(msg, ren, run);
+					};
+
+					auto steadyRun = std::make_shared<TextRun>();
+					benchmarks.push_back({prefix + "/steady", [=] {
+						create({"12:34", fontFile, {{0}, {0}, {255, 255, 255}}, size}, *steadyRun);
+					}});
+
+					auto reshapeRun = std::make_shared<TextRun>();
+					auto minute = std::make_shared<int>(0);
+					benchmarks.push_back({prefix + "/reshape", [=] {
+						*minute = (*minute + 1) % 60;
+						create({std::format("12:{:02}", *minute), fontFile, {{0}, {0}, {255, 255, 255}}, size}, *reshapeRun);
+					}});
+
+					// a theme change, outlined runs only shade their field again
+					if (outline) {
+						auto recolorRun = std::make_shared<TextRun>();
+						auto isPink = std::make_shared<bool>(false);
+						benchmarks.push_back({prefix + "/recolor", [=] {
+							*isPink = !*isPink;
+							create({"12:34", fontFile, {{0}, {0}, *isPink ? SDL_Color {255, 163, 210} : SDL_Color {255, 255, 255}}, size}, *recolorRun);
+						}});
+					}
+				}
+			}
+		} else {
+			std::cerr << "Skipping the text benchmarks, font not found: " << fontFile << '\n';
+		}
+
+		// decodes & packs every frame again, the previous pages are released when the pack is replaced
+		const auto packPath = dirPath + "assets/gif-extract/";
+		if (std::filesystem::exists(packPath)) {
+			benchmarks.push_back({"image/createPack/gif-extract", [=] {
+				image->createPack("canvas", packPath, ren);
+			}});
+		} else {
+			std::cerr << "Skipping the pack benchmark, directory not found: " << packPath << '\n';
+		}
+
+		// a blank 8 frame sheet, the cost is in the bookkeeping & the batching, not the pixels
+		auto anim = std::make_shared<Animation>(queue);
+		auto sheet = std::make_shared<ImageData>();
+		sheet->texture = Utilities::PTR<SDL_Texture>(SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 8 * 32, 32));
+		if (sheet->texture != nullptr) {
+			const uint32_t clip = anim->addClip("walk", sheet, 8, 0, 0, 32, 32, 37.0f);
+			for (int i = 0; i < 100; ++i)
+				anim->play(clip, 0.5f + static_cast<float>(i % 4) * 0.25f);
+
+			benchmarks.push_back({"animation/update/100", [=] {
+				anim->update(16.0);
+			}});
+			benchmarks.push_back({"animation/draw/100", [=] {
+				for (uint32_t i = 0; i < 100; ++i)
+					anim->draw(i, ren, static_cast<int>(i % 10) * 14, static_cast<int>(i / 10) * 8);
+				queue->flush(ren);
+			}});
+		} else {
+			std::cerr << "Skipping the animation benchmarks: " << SDL_GetError() << '\n';
+		}
+
+		// a noisy 1080p frame scaled down & up by fractional factors, the kernels are picked from the CPU
+		auto frame = std::shared_ptr<SDL_Surface>(SDL_CreateRGBSurfaceWithFormat(0, 1920, 1080, 32, SDL_PIXELFORMAT_ARGB8888), SDL_FreeSurface);
+		if (frame != nullptr) {
+			uint32_t seed = 1;
+			for (int y = 0; y < frame->h; ++y) {
+				uint32_t *row = reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(frame->pixels) + static_cast<size_t>(y) * frame->pitch);
+				for (int x = 0; x < frame->w; ++x)
+					row[x] = seed = seed * 1664525u + 1013904223u;
+			}
+
+			std::cerr << "Resample kernels: " << getResampleKernels() << '\n';
+			for (const auto &[filterName, filter] : {std::pair {"box", ResampleFilter::Box}, {"bilinear", ResampleFilter::Bilinear}, {"lanczos", ResampleFilter::Lanczos}}) {
+				for (const auto &[width, height] : {std::pair {1280, 720}, {2880, 1620}}) {
+					benchmarks.push_back({std::format("resample/{}/1920x1080-{}x{}", filterName, width, height), [=] {
+						freeSurface(resample(frame.get(), nullptr, width, height, filter));
+					}});
+				}
+			}
+		} else {
+			std::cerr << "Skipping the resample benchmarks: " << SDL_GetError() << '\n';
+		}
+
+		// buttons in a grid, the mouse hovers the first one
+		for (const int count : {10, 100, 1000}) {
+			auto ui = std::make_shared<UInterface>(queue, image->getTextPtr());
+			for (int i = 0; i < count; ++i)
+				ui->setButtonEnabled(ui->createButton("x", (i % 32) * 4, (i / 32) * 4, 12, 12), true);
+
+			SDL_Event motion {};
+			motion.type = SDL_MOUSEMOTION;
+			motion.motion.x = 6;
+			motion.motion.y = 6;
+			ui->handleEvent(motion);
+
+			benchmarks.push_back({std::format("uinterface/update/{}", count), [=] {
+				ui->update(16.0);
+			}});
+		}
+
+		// the hooks are trivial, what's left is the dispatch through the scene table
+		auto scene = std::make_shared<Scene>();
+		auto calls = std::make_shared<int64_t>(0);
+		for (size_t id = 0; id < static_cast<size_t>(SceneID::Count); ++id) {
+			scene->createScene(static_cast<SceneID>(id), {
+				.enter = [calls] {++*calls;},
+				.update = [calls](double) {++*calls;},
+				.draw = [calls] {++*calls;},
+				.exit = [calls] {++*calls;}
+			});
+		}
+		scene->setScene(SceneID::Main);
+
+		benchmarks.push_back({"scene/update+draw", [=] {
+			scene->update(16.0);
+			scene->draw();
+		}});
+		auto next = std::make_shared<size_t>(0);
+		benchmarks.push_back({"scene/setScene", [=] {
+			*next = (*next + 1) % static_cast<size_t>(SceneID::Count);
+			scene->setScene(static_cast<SceneID>(*next));
+		}});
+
+		std::vector<Result> results {};
+		for (const auto &bench : benchmarks) {
+			if (!filter.empty() && !bench.name.contains(filter))
+				continue;
+
+			results.emplace_back(measure(bench, samples));
+			std::cerr << std::format("{:<40} {:>12.1f} ns\n", results.back().name, results.back().median);
+		}
+		const auto json = toJSON(results);
+		if (outPath.empty()) {
+			std::cout << json;
+		} else {
+			std::ofstream file {outPath};
+			if (file) {
+				file << json;
+			} else {
+				std::cerr << "Failed to write the results: " << outPath << '\n';
+				exitCode = 1;
+			}
+		}
+
+		if (!baselinePath.empty()) {
+			std::unordered_map<std::basic_string<char>, double> baseline {};
+			int missing = 0;
+			if (!readBaseline(baselinePath, baseline)) {
+				exitCode = 1;
+			} else if (baseline.empty() && !allowNew) {
+				// an empty baseline would pass everything as new
+				std::cerr << "The baseline has no results: " << baselinePath << '\n';
+				exitCode = 1;
+			} else if (const int regressions = compare(results, baseline, threshold, missing); regressions > 0) {
+				std::cerr << regressions << " benchmark(s) regressed by more than " << threshold * 100.0 << "%\n";
+				exitCode = 1;
+			}
+
+			if (missing > 0 && !allowNew) {
+				std::cerr << missing << " benchmark(s) are missing from the baseline, refresh it or pass --allow-new\n";
+				exitCode = 1;
+			}
+		}
+	}
+
+	renderer.reset();
+	window.reset();
+	TTF_Quit();
+	IMG_Quit();
+	SDL_Quit();
+
+	return exitCode;
+}
\ No newline at end of file
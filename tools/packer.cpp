@@ -0,0 +1,122 @@
+#include <SDL.h>
+#include <SDL_image.h>
+#include "bundle.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// builds the asset bundle read by Image::openBundle
+// usage: time_packer <assets directory> <output bundle>
+
+using namespace Application::Helper;
+
+struct PackedImage final {
+	BundleEntry entry {};
+	SDL_Surface *surface {nullptr};
+};
+
+int main(int argc, char **argv) {
+	if (argc != 3) {
+		std::cout << "usage: " << argv[0] << " <assets directory> <output bundle>\n";
+		return 1;
+	}
+
+	const std::filesystem::path root = argv[1];
+	const std::filesystem::path output = argv[2];
+
+	if (IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG) == 0) {
+		std::cout << "IMG_Init error: " << IMG_GetError() << '\n';
+		return 1;
+	}
+
+	std::vector<PackedImage> images {};
+	for (const auto &pathIter : std::filesystem::recursive_directory_iterator(root)) {
+		if (!pathIter.is_regular_file())
+			continue;
+
+		auto extension = pathIter.path().extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {return static_cast<char>(std::tolower(c));});
+		if (extension != ".png" && extension != ".jpg" && extension != ".jpeg")
+			continue;
+
+		const auto name = std::filesystem::relative(pathIter.path(), root).generic_string();
+		PackedImage image {};
+		if (name.size() >= image.entry.name.size()) {
+			std::cout << "Skipping (name is too long): " << name << '\n';
+			continue;
+		}
+
+		SDL_Surface *surf = IMG_Load(pathIter.path().string().c_str());
+		if (surf == nullptr) {
+			std::cout << "Skipping (" << IMG_GetError() << "): " << name << '\n';
+			continue;
+		}
+
+		// convert now so the app never has to
+		image.surface = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0);
+		SDL_FreeSurface(surf);
+		if (image.surface == nullptr) {
+			std::cout << "Skipping (" << SDL_GetError() << "): " << name << '\n';
+			continue;
+		}
+
+		std::copy(name.begin(), name.end(), image.entry.name.begin());
+		image.entry.width = static_cast<uint32_t>(image.surface->w);
+		image.entry.height = static_cast<uint32_t>(image.surface->h);
+		image.entry.pitch = image.entry.width * sizeof(uint32_t);
+		image.entry.size = image.entry.pitch * image.entry.height;
+		image.entry.sourceSize = static_cast<uint64_t>(pathIter.file_size());
+		images.emplace_back(image);
+	}
+
+	// the index is binary searched by name
+	std::sort(images.begin(), images.end(), [](const PackedImage &a, const PackedImage &b) {
+		return std::string_view(a.entry.name.data()) < std::string_view(b.entry.name.data());
+	});
+
+	BundleHeader header {};
+	header.count = static_cast<uint32_t>(images.size());
+
+	uint64_t offset = sizeof(BundleHeader) + images.size() * sizeof(BundleEntry);
+	for (auto &image : images) {
+		offset = (offset + Bundle::alignment - 1) / Bundle::alignment * Bundle::alignment;
+		image.entry.offset = offset;
+		offset += image.entry.size;
+	}
+
+	std::ofstream file(output, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		std::cout << "Failed to open output: " << output << '\n';
+		return 1;
+	}
+
+	file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	for (const auto &image : images)
+		file.write(reinterpret_cast<const char *>(&image.entry), sizeof(image.entry));
+
+	for (auto &image : images) {
+		const std::vector<char> padding(static_cast<size_t>(image.entry.offset - file.tellp()), 0);
+		file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+		// write row by row, the surface pitch may be padded
+		SDL_LockSurface(image.surface);
+		const auto *pixels = static_cast<const char *>(image.surface->pixels);
+		for (uint32_t y = 0; y < image.entry.height; ++y)
+			file.write(pixels + static_cast<size_t>(y) * image.surface->pitch, image.entry.pitch);
+		SDL_UnlockSurface(image.surface);
+
+		SDL_FreeSurface(image.surface);
+	}
+
+	if (!file) {
+		std::cout << "Failed to write bundle: " << output << '\n';
+		return 1;
+	}
+
+	std::cout << "Packed " << images.size() << " images into " << output << " (" << offset << " bytes)\n";
+	IMG_Quit();
+
+	return 0;
+}
\ No newline at end of file